@@ -0,0 +1,257 @@
+#ifndef APPENDFILE_H
+#define APPENDFILE_H
+
+/**
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <locale>
+#include <system_error>
+#include <type_traits>
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include "OutputManagerEncoding.h"
+
+/**
+ * @brief An output stream appending whole lines to a file that other processes append to as well.
+ *
+ * @details The file is opened with `O_APPEND` and output is kept until a batch of `BatchSize` bytes is full or the stream is flushed. Then every complete line in it is written, the last incomplete one is kept for the next batch. A flush writes everything, incomplete line included.
+ * @details With the default `BatchSize` of `PIPE_BUF` each write is at most `PIPE_BUF` bytes and made of whole lines, so it is a single `write` that does not need a lock. A larger `BatchSize` writes all the complete lines of a batch at once, while holding an exclusive `flock` on the file, so several lines go out in one system call and writers that lock too never interleave with it, even if the `write` is cut short by a signal. A single line longer than `PIPE_BUF` is written under the lock as well.
+ * @details If a write fails the stream sets `badbit` and keeps what was not written, so clearing the state and flushing again retries it.
+ * @details Wide characters are encoded by the `std::codecvt` of the locale of the stream, see OutputManagerDetail::Encode(). Imbue a UTF-8 locale to keep every character; the classic `"C"` locale writes `?` for any character outside ASCII.
+ *
+ * **Example:**
+ * ```.cpp
+ * #include "OutputManager.h"
+ * #include "AppendFile.h"
+ *
+ * int main () {
+ *     AppendFile File("shared.log", 1 << 16);
+ *     OutputManager O(File);
+ *     for (int i = 0; i < 1000; ++i) {
+ *         O(getpid(), i);
+ *     }
+ * }
+ * ```
+ * @tparam CharT The character type of the stream.
+ * @tparam Traits The character traits of the stream.
+ * @warning Every process writing to the file must use an AppendFile, or otherwise write whole lines with `O_APPEND`, for lines not to tear. Locking is advisory and may not work on network file systems.
+ */
+template<typename CharT = wchar_t, typename Traits = std::char_traits<CharT>> class AppendFile : public std::basic_ostream<CharT, Traits> {
+	protected:
+		/**
+		 * @brief The stream buffer keeping the batch and writing its lines.
+		 */
+		class LineBuffer__ : public std::basic_streambuf<CharT, Traits> {
+			protected:
+				using Int__ = typename Traits::int_type;
+
+				/**
+				 * @brief The file descriptor written to.
+				 */
+				int Descriptor__;
+				/**
+				 * @brief `true` if the descriptor is closed with the buffer.
+				 */
+				bool Owned__;
+				/**
+				 * @brief The size in bytes at which a batch is written.
+				 */
+				size_t Batch__;
+				/**
+				 * @brief The batch, used as put area.
+				 */
+				std::vector<CharT> Storage__;
+				/**
+				 * @brief The encoded text not written yet, for wide streams.
+				 */
+				std::string Encoded__;
+				/**
+				 * @brief The shift state of the encoding.
+				 */
+				std::mbstate_t State__{};
+
+				/**
+				 * @brief Writes `Size` bytes at once, under an exclusive `flock` if more than `PIPE_BUF`.
+				 * @return The number of bytes written, less than `Size` if writing or locking failed.
+				 */
+				size_t Write__(const char* Data, size_t Size) {
+					const bool Locked = Size > PIPE_BUF;
+					if (Locked) {
+						while (flock(Descriptor__, LOCK_EX) < 0) {
+							if (errno != EINTR) {
+								return 0;
+							}
+						}
+					}
+					size_t Done = 0;
+					while (Done < Size) {
+						const ssize_t Result = write(Descriptor__, Data + Done, Size - Done);
+						if (Result < 0) {
+							if (errno == EINTR) {
+								continue;
+							}
+							break;
+						}
+						Done += Result;
+					}
+					if (Locked) {
+						flock(Descriptor__, LOCK_UN);
+					}
+					return Done;
+				}
+				/**
+				 * @brief Writes the complete lines of the batch, or all of it if `All` is `true`, and moves what is left to the front.
+				 *
+				 * @details Lines are grouped in writes of at most `PIPE_BUF` bytes, unless the batch size is larger, in which case they all go in one write. If a write fails, what was not written stays in the batch for the next try. A batch grown by a long line shrinks back to `Batch__` once the line is out. A wide batch is first encoded as a whole into `Encoded__`, where the lines are looked for and what is not written is kept.
+				 * @return `false` if writing failed.
+				 */
+				bool Commit__(bool All) {
+					CharT* const Begin = this->pbase();
+					size_t Size = this->pptr() - Begin;
+					const char* Bytes = nullptr;
+					if constexpr (std::is_same_v<CharT, char>) {
+						Bytes = Begin;
+					}
+					else {
+						OutputManagerDetail::Encode(this->getloc(), Begin, Begin + Size, Encoded__, State__);
+						this->setp(Storage__.data(), Storage__.data() + Storage__.size());
+						Bytes = Encoded__.data();
+						Size = Encoded__.size();
+					}
+					size_t End = Size;
+					if (!All) {
+						while (End && Bytes[End - 1] != '\n') {
+							--End;
+						}
+					}
+					size_t Written = 0;
+					const size_t Limit = Batch__ > PIPE_BUF ? End : PIPE_BUF;
+					for (size_t Start = 0; Written == Start && Start < End;) {
+						size_t Stop = End;
+						if (End - Start > Limit) {
+							Stop = Start + Limit;
+							while (Stop > Start && Bytes[Stop - 1] != '\n') {
+								--Stop;
+							}
+							//A line longer than the limit goes alone.
+							if (Stop == Start) {
+								Stop = Start + Limit;
+								while (Stop < End && Bytes[Stop - 1] != '\n') {
+									++Stop;
+								}
+							}
+						}
+						Written += Write__(Bytes + Start, Stop - Start);
+						Start = Stop;
+					}
+					if constexpr (std::is_same_v<CharT, char>) {
+						Traits::move(Begin, Begin + Written, Size - Written);
+						const size_t Left = Size - Written;
+						if (Storage__.size() > Batch__ && Left <= Batch__) {
+							Storage__.resize(Batch__);
+							Storage__.shrink_to_fit();
+						}
+						this->setp(Storage__.data(), Storage__.data() + Storage__.size());
+						this->pbump(static_cast<int>(Left));
+					}
+					else {
+						Encoded__.erase(0, Written);
+					}
+					return Written == End;
+				}
+
+				Int__ overflow(Int__ Character) override {
+					if (!Commit__(false)) {
+						return Traits::eof();
+					}
+					if (Traits::eq_int_type(Character, Traits::eof())) {
+						return Traits::not_eof(Character);
+					}
+					//A single line fills the whole batch, which grows until the line ends.
+					if (this->pptr() == this->epptr()) {
+						const size_t Size = Storage__.size();
+						Storage__.resize(2 * Size);
+						this->setp(Storage__.data(), Storage__.data() + Storage__.size());
+						this->pbump(static_cast<int>(Size));
+					}
+					*this->pptr() = Traits::to_char_type(Character);
+					this->pbump(1);
+					return Character;
+				}
+				int sync() override {
+					return Commit__(true) ? 0 : -1;
+				}
+
+			public:
+				LineBuffer__(int Descriptor, bool Owned, size_t BatchSize) : Descriptor__{Descriptor}, Owned__{Owned}, Batch__{BatchSize ? BatchSize : 1}, Storage__(Batch__) {
+					this->setp(Storage__.data(), Storage__.data() + Storage__.size());
+				}
+				~LineBuffer__() override {
+					Commit__(true);
+					if (Owned__) {
+						close(Descriptor__);
+					}
+				}
+		};
+
+		/**
+		 * @brief The buffer of the stream.
+		 */
+		LineBuffer__ Lines__;
+
+	public:
+		AppendFile(AppendFile const&) = delete;
+		AppendFile& operator=(AppendFile const&) = delete;
+
+		/**
+		 * @brief Opens, or creates, the file at `Path` for appending.
+		 * @param BatchSize The size in bytes of the batches, see the class description.
+		 * @throw std::system_error If the file cannot be opened.
+		 */
+		explicit AppendFile(std::string const& Path, size_t BatchSize = PIPE_BUF);
+		/**
+		 * @brief Appends to an open file descriptor, which should have `O_APPEND` set, such as a pipe. The descriptor is not closed.
+		 * @param BatchSize The size in bytes of the batches, see the class description.
+		 */
+		explicit AppendFile(int FileDescriptor, size_t BatchSize = PIPE_BUF);
+};
+
+//
+//CONSTRUCTORS
+//
+namespace AppendFileDetail {
+	/**
+	 * @brief Opens `Path` for appending, creating it if needed.
+	 * @throw std::system_error If the file cannot be opened.
+	 */
+	inline int Open(std::string const& Path) {
+		const int Descriptor = open(Path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+		if (Descriptor < 0) {
+			throw std::system_error(errno, std::generic_category(), "AppendFile: cannot open " + Path);
+		}
+		return Descriptor;
+	}
+}
+
+template<typename CharT, typename Traits>
+AppendFile<CharT, Traits> ::AppendFile(std::string const& Path, size_t BatchSize) : std::basic_ostream<CharT, Traits>(nullptr), Lines__(AppendFileDetail::Open(Path), true, BatchSize) {
+	this->init(&Lines__);
+}
+
+template<typename CharT, typename Traits>
+AppendFile<CharT, Traits> ::AppendFile(int FileDescriptor, size_t BatchSize) : std::basic_ostream<CharT, Traits>(nullptr), Lines__(FileDescriptor, false, BatchSize) {
+	this->init(&Lines__);
+}
+
+#endif
+#endif
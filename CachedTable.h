@@ -0,0 +1,410 @@
+#ifndef CACHEDTABLE_H
+#define CACHEDTABLE_H
+
+/**
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "OutputManagerEncoding.h"
+#include <string>
+#include <vector>
+#include <sstream>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <cmath>
+#include <locale>
+#include <cwchar>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+/**
+ * @brief A table of lines which are only formatted again when their values change.
+ * 
+ * @details Every row keeps its formatted text and a hash of the values it was formatted from. Set(size_t, T const&...) formats a row only if the hash of the new values differs, Emit() writes all rows to the stream of the OutputManager, and Patch(int, off_t) rewrites in place, in a file, only the rows that changed since the last write, as long as they kept their length.
+ * 
+ * **Example:**
+ * ```.cpp
+ * #include <fstream>
+ * #include "CachedTable.h"
+ * 
+ * int main () {
+ *     std::wostringstream Stream;
+ *     OutputManager O(Stream);
+ *     O.SetWidth(6);
+ *     CachedTable Table(O);
+ *     for (int Row = 0; Row < 1000; ++Row) {
+ *         Table.Set(Row, Row, Row * 2);
+ *     }
+ *     Table.Emit();
+ *     Table.Set(10, 10, 0); //Only this row is formatted again.
+ *     Table.Emit();
+ * }
+ * ```
+ * @tparam OutType The type of the output stream of the OutputManager.
+ * @tparam StringType The type of the separator and and of line strings of the OutputManager.
+ * @warning Rows are formatted with the settings of the OutputManager at the time they change. After changing them, call Invalidate() to format all rows again.
+ * @note If the OutputManager puts a timestamp before every line, rows are kept without it and stamped with the current time every time they are written, so Patch(int, off_t) rewrites every row holding values.
+ */
+template<typename OutType = std::wostream, typename StringType = std::wstring> class CachedTable {
+	protected:
+		using Char__ = typename OutType::char_type;
+		using Text__ = std::basic_string<Char__, typename OutType::traits_type>;
+		using Stream__ = std::basic_ostream<Char__, typename OutType::traits_type>;
+		/**
+		 * @brief A single row of the table.
+		 */
+		struct Row__ {
+			/**
+			 * @brief The formatted line, end of line included.
+			 */
+			Text__ Text;
+			/**
+			 * @brief The hash of the values `Text` was formatted from.
+			 */
+			size_t Hash = 0;
+			/**
+			 * @brief A copy of the values `Text` was formatted from, compared when the hashes match, and the tag of their types.
+			 * @see Same__(Row__ const&, T const&...)
+			 */
+			std::shared_ptr<void> Values;
+			const void* Types = nullptr;
+			/**
+			 * @brief The number of bytes the row took in the encoding of the stream the last time it was written, `Text__::npos` if it never was.
+			 */
+			size_t Written = Text__::npos;
+			/**
+			 * @brief `true` if `Text` holds a formatted line.
+			 */
+			bool Formatted = false;
+			/**
+			 * @brief `true` if the row holds values, and so gets a timestamp when the OutputManager has one.
+			 */
+			bool Stamped = false;
+			/**
+			 * @brief `true` if `Text` changed since the row was last written.
+			 */
+			bool Dirty = true;
+		};
+
+		/**
+		 * @brief The OutputManager whose settings and stream are used.
+		 */
+		OutputManager<OutType, StringType>& Manager__;
+		/**
+		 * @brief The rows, in order.
+		 */
+		std::vector<Row__> Rows__;
+		/**
+		 * @brief The stream rows are formatted into.
+		 */
+		std::basic_ostringstream<Char__, typename OutType::traits_type> Scratch__;
+		/**
+		 * @brief An OutputManager writing to `Scratch__`, with the settings of `Manager__`.
+		 */
+		OutputManager<Stream__, StringType> Formatter__;
+		/**
+		 * @brief The encoding of the rows, for wide streams.
+		 */
+		std::string Encoded__;
+
+		/**
+		 * @brief The character type of `T` if it is a string of any character type, whatever the one of the stream, `void` otherwise.
+		 */
+		template<typename T> using TextChar__ = std::conditional_t<OutputManagerDetail::IsString<T, char>::value, char,
+			std::conditional_t<OutputManagerDetail::IsString<T, wchar_t>::value, wchar_t,
+			std::conditional_t<OutputManagerDetail::IsString<T, char16_t>::value, char16_t,
+			std::conditional_t<OutputManagerDetail::IsString<T, char32_t>::value, char32_t, void>>>>;
+		/**
+		 * @brief The type a value of type `T` is kept as: strings of characters by content, everything else as it is.
+		 */
+		template<typename T> using Stored__ = typename std::conditional_t<std::is_void_v<TextChar__<T>>, std::decay<T>, std::enable_if<true, std::basic_string<TextChar__<T>>>>::type;
+		/**
+		 * @brief A tag whose address tells apart the types of the values kept by a row.
+		 */
+		template<typename... T> static constexpr char Types__ = 0;
+
+		/**
+		 * @brief The characters of a string, a null pointer counting as an empty string, or any other value as it is.
+		 */
+		template<typename T> static decltype(auto) Key__(T const& Value);
+		/**
+		 * @brief Combines the hashes of all values.
+		 *
+		 * @details Strings of any character type are hashed by content, every other type with `std::hash`.
+		 */
+		template<typename... T> static size_t Hash__(T const&... Values);
+		/**
+		 * @brief Tells if a row was formatted from values of the same types and equal to `Values`.
+		 */
+		template<typename... T> static bool Same__(Row__ const& Entry, T const&... Values);
+		/**
+		 * @brief Compares the kept values with `Values`, one by one.
+		 */
+		template<typename Tuple, size_t... I, typename... T> static bool Equal__(Tuple const& Kept, std::index_sequence<I...>, T const&... Values);
+		/**
+		 * @brief Tells if a kept value prints the same as `Value`: floating point numbers must also have the same sign, since `-0.0 == 0.0` prints differently.
+		 */
+		template<typename K, typename T> static bool Equal__(K const& Kept, T const& Value);
+		/**
+		 * @brief The timestamp and separator put before the rows holding values, empty if the OutputManager has no timestamp.
+		 */
+		Text__ Stamp__();
+
+	public:
+		CachedTable(CachedTable const&) = delete;
+		CachedTable& operator=(CachedTable const&) = delete;
+
+		/**
+		 * @brief Creates an empty table.
+		 * @param Manager The OutputManager whose settings are used to format rows and whose stream is written to by Emit().
+		 */
+		CachedTable(OutputManager<OutType, StringType>& Manager);
+
+		/**
+		 * @brief Sets the values of a row, formatting it only if they changed.
+		 *
+		 * @details The row is formatted as operator()(T&&, P&&...) would print it. The table grows if `Row` is past its end. A copy of the values is kept with the row, so that values whose hash matches the old one are still compared before the row is skipped.
+		 * @warning Every type in `T` must be printable, copyable, comparable with `==` and hashable with `std::hash`, or a string of any character type, kept by content.
+		 * @return `true` if the row was formatted again.
+		 */
+		template<typename... T> bool Set(size_t Row, T const&... Values);
+		/**
+		 * @brief Changes the number of rows. New rows are empty.
+		 */
+		void Resize(size_t Rows);
+		/**
+		 * @brief The number of rows.
+		 */
+		size_t Size() const;
+		/**
+		 * @brief Forgets the values of all rows, so that the next Set(size_t, T const&...) of each formats it again.
+		 */
+		void Invalidate();
+		/**
+		 * @brief Writes all rows to the stream of the OutputManager.
+		 */
+		void Emit();
+#if defined(__unix__) || defined(__APPLE__)
+		/**
+		 * @brief Rewrites, in a file already holding the table, only the rows that changed since it was last written.
+		 * 
+		 * @details Every changed row is written at its position with `pwrite`, which is only possible if all of them kept their length in bytes, as with fixed width columns. Wide characters are encoded by the `std::codecvt` of the locale of the stream of the OutputManager, see OutputManagerDetail::Encode(), and the positions of the rows are counted in bytes of that encoding, so a wide row keeping its number of characters but not of bytes is refused. Encodings with a shift state, where the bytes of a row depend on the rows before it, are refused as well.
+		 * @param FileDescriptor The file, opened for writing.
+		 * @param Offset The position in bytes of the first row in the file.
+		 * @return `true` if the file was patched, `false` if some row changed length, the encoding has a shift state or a write failed, in which case the table must be written again with Emit().
+		 */
+		bool Patch(int FileDescriptor, off_t Offset = 0);
+#endif
+};
+
+//
+//CONSTRUCTORS
+//
+template<typename OutType, typename StringType>
+CachedTable<OutType, StringType> ::CachedTable(OutputManager<OutType, StringType>& Manager) : Manager__{Manager}, Formatter__{Scratch__} {
+}
+
+//
+//ROWS
+//
+template<typename OutType, typename StringType>
+template<typename... T>
+bool CachedTable<OutType, StringType> ::Set(size_t Row, T const&... Values) {
+	if (Row >= Rows__.size()) {
+		Rows__.resize(Row + 1);
+	}
+	Row__& Entry = Rows__[Row];
+	const size_t Hash = Hash__(Values...);
+	//The hash only rules out most changes quickly, equal hashes may still hide different values.
+	if (Entry.Formatted && Entry.Hash == Hash && Same__(Entry, Values...)) {
+		return false;
+	}
+	Manager__.CopySettingsTo__(Formatter__);
+	//Rows are stamped when written, not when formatted.
+	if (Formatter__.Extras__) {
+		Formatter__.Extras__->Timestamp.reset();
+	}
+	Scratch__.str(Text__());
+	//A null string sets badbit, which must not blank the rows formatted after it.
+	Scratch__.clear();
+	if constexpr (sizeof...(T)) {
+		Formatter__(Values...);
+	}
+	else {
+		Formatter__();
+	}
+	Text__ Text = Scratch__.str();
+	Entry.Dirty = Entry.Dirty || Text != Entry.Text;
+	Entry.Text = std::move(Text);
+	Entry.Hash = Hash;
+	Entry.Values = std::make_shared<std::tuple<Stored__<T>...>>(Stored__<T>(Key__(Values))...);
+	Entry.Types = &Types__<Stored__<T>...>;
+	Entry.Formatted = true;
+	Entry.Stamped = sizeof...(T) != 0;
+	return true;
+}
+
+template<typename OutType, typename StringType>
+void CachedTable<OutType, StringType> ::Resize(size_t Rows) {
+	Rows__.resize(Rows);
+}
+
+template<typename OutType, typename StringType>
+size_t CachedTable<OutType, StringType> ::Size() const {
+	return Rows__.size();
+}
+
+template<typename OutType, typename StringType>
+void CachedTable<OutType, StringType> ::Invalidate() {
+	for (auto& Entry : Rows__) {
+		Entry.Formatted = false;
+	}
+}
+
+//
+//OUTPUT
+//
+template<typename OutType, typename StringType>
+void CachedTable<OutType, StringType> ::Emit() {
+	auto& Buffer = Manager__.Buffer__;
+	const std::locale Locale = Manager__.OutStream__.getloc();
+	//Only an encoding of more than one byte for some characters needs the rows encoded to measure them.
+	const bool Measure = !std::is_same_v<Char__, char> && std::use_facet<std::codecvt<Char__, char, std::mbstate_t>>(Locale).encoding() != 1;
+	for (auto& Entry : Rows__) {
+		if (Entry.Stamped) {
+			Manager__.StartLine__();
+		}
+		Buffer.Append(Entry.Text.data(), Entry.Text.size());
+		Entry.Written = Buffer.Size();
+		if (Measure) {
+			std::mbstate_t State{};
+			Encoded__.clear();
+			Entry.Written = OutputManagerDetail::Encode(Locale, Buffer.Data(), Buffer.Data() + Buffer.Size(), Encoded__, State);
+		}
+		Entry.Dirty = false;
+		Manager__.Flush__();
+	}
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+template<typename OutType, typename StringType>
+bool CachedTable<OutType, StringType> ::Patch(int FileDescriptor, off_t Offset) {
+	const std::locale Locale = Manager__.OutStream__.getloc();
+	if (std::use_facet<std::codecvt<Char__, char, std::mbstate_t>>(Locale).encoding() < 0) {
+		return false;
+	}
+	//Every stamped row is written again with the time of this call.
+	const Text__ Stamp = Stamp__();
+	//The changed rows are encoded first, so that nothing is written unless all of them kept their length.
+	Encoded__.clear();
+	for (auto& Entry : Rows__) {
+		Entry.Dirty = Entry.Dirty || (Entry.Stamped && !Stamp.empty());
+		if (Entry.Dirty) {
+			std::mbstate_t State{};
+			size_t Length = 0;
+			if (Entry.Stamped) {
+				Length += OutputManagerDetail::Encode(Locale, Stamp.data(), Stamp.data() + Stamp.size(), Encoded__, State);
+			}
+			Length += OutputManagerDetail::Encode(Locale, Entry.Text.data(), Entry.Text.data() + Entry.Text.size(), Encoded__, State);
+			if (Length != Entry.Written) {
+				return false;
+			}
+		}
+	}
+	const char* Bytes = Encoded__.data();
+	for (auto& Entry : Rows__) {
+		if (Entry.Dirty) {
+			for (size_t Done = 0; Done < Entry.Written;) {
+				const ssize_t Result = pwrite(FileDescriptor, Bytes + Done, Entry.Written - Done, Offset + Done);
+				if (Result < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					return false;
+				}
+				Done += Result;
+			}
+			Bytes += Entry.Written;
+			Entry.Dirty = false;
+		}
+		Offset += Entry.Written;
+	}
+	return true;
+}
+#endif
+
+//
+//HELPERS
+//
+template<typename OutType, typename StringType>
+template<typename T>
+decltype(auto) CachedTable<OutType, StringType> ::Key__(T const& Value) {
+	using CharT = TextChar__<T>;
+	if constexpr (std::is_void_v<CharT>) {
+		return (Value);
+	}
+	else if constexpr (std::is_pointer_v<T>) {
+		return Value ? std::basic_string_view<CharT>(Value) : std::basic_string_view<CharT>();
+	}
+	else {
+		return std::basic_string_view<CharT>(Value);
+	}
+}
+
+template<typename OutType, typename StringType>
+template<typename... T>
+size_t CachedTable<OutType, StringType> ::Hash__(T const&... Values) {
+	size_t Hash = sizeof...(T);
+	([&](auto const& Value) {
+		const auto& Key = Key__(Value);
+		const size_t Current = std::hash<std::decay_t<decltype(Key)>>()(Key);
+		Hash ^= Current + 0x9e3779b97f4a7c15ull + (Hash << 6) + (Hash >> 2);
+	}(Values),...);
+	return Hash;
+}
+
+template<typename OutType, typename StringType>
+template<typename... T>
+bool CachedTable<OutType, StringType> ::Same__(Row__ const& Entry, T const&... Values) {
+	if (Entry.Types != &Types__<Stored__<T>...>) {
+		return false;
+	}
+	return Equal__(*static_cast<std::tuple<Stored__<T>...> const*>(Entry.Values.get()), std::index_sequence_for<T...>(), Values...);
+}
+
+template<typename OutType, typename StringType>
+template<typename Tuple, size_t... I, typename... T>
+bool CachedTable<OutType, StringType> ::Equal__(Tuple const& Kept, std::index_sequence<I...>, T const&... Values) {
+	return (Equal__(std::get<I>(Kept), Key__(Values)) && ...);
+}
+
+template<typename OutType, typename StringType>
+template<typename K, typename T>
+bool CachedTable<OutType, StringType> ::Equal__(K const& Kept, T const& Value) {
+	if constexpr (std::is_floating_point_v<K>) {
+		return Kept == Value && std::signbit(Kept) == std::signbit(Value);
+	}
+	else {
+		return Kept == Value;
+	}
+}
+
+template<typename OutType, typename StringType>
+typename CachedTable<OutType, StringType>::Text__ CachedTable<OutType, StringType> ::Stamp__() {
+	if (!Manager__.Timestamp__()) {
+		return Text__();
+	}
+	Manager__.StartLine__();
+	Text__ Stamp(Manager__.Buffer__.Data(), Manager__.Buffer__.Size());
+	Manager__.Buffer__.Clear();
+	return Stamp;
+}
+
+#endif
@@ -0,0 +1,974 @@
+#ifndef DEFERREDLOG_H
+#define DEFERREDLOG_H
+
+/**
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <tuple>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <exception>
+#include <type_traits>
+#include <limits>
+
+/**
+ * @brief Logs one line holding the values after `Log` with the DeferredLog `Log`, with an id of its own for this call site, see DeferredLog::LogAt(Tag, T const&...).
+ */
+#define OUTPUTMANAGER_LOG(Log, ...) (Log).LogAt([]() {}, __VA_ARGS__)
+
+namespace DeferredLogDetail {
+	/**
+	 * @brief The values stored as they are in memory, identified by their index.
+	 */
+	using Scalars = std::tuple<bool, char, signed char, unsigned char, wchar_t, short, unsigned short, int, unsigned int, long, unsigned long, long long, unsigned long long, float, double, long double>;
+	/**
+	 * @brief The kind of narrow strings, stored as their length followed by their characters.
+	 */
+	constexpr uint8_t Text = std::tuple_size_v<Scalars>;
+	/**
+	 * @brief The kind of wide strings, stored like narrow ones.
+	 */
+	constexpr uint8_t WideText = Text + 1;
+	/**
+	 * @brief The length stored for null string pointers.
+	 */
+	constexpr uint32_t NullText = UINT32_MAX;
+	/**
+	 * @brief Set in the first word of a record defining a call site instead of logging one.
+	 */
+	constexpr uint32_t Definition = 1u << 31;
+	/**
+	 * @brief The number of call site ids, which bounds what a decoder allocates for a corrupted log.
+	 */
+	constexpr uint32_t MaxSites = 1 << 16;
+	/**
+	 * @brief The largest width and precision a decoder applies, which bound what it allocates for a corrupted log.
+	 */
+	constexpr uint64_t MaxWidth = 1 << 16;
+	constexpr int64_t MaxPrecision = 1 << 16;
+	/**
+	 * @brief The start of a binary log: a tag, a version, the sizes that vary between platforms and a word telling the byte order. It is followed by the length of the settings stored in the log, `0` if none, and the settings.
+	 */
+	constexpr char Magic[4] = {'O', 'M', 'D', 'L'};
+	constexpr uint8_t Version = 2;
+	constexpr uint8_t Sizes[3] = {sizeof(wchar_t), sizeof(long), sizeof(long double)};
+	constexpr uint32_t ByteOrder = 0x01020304;
+
+	/**
+	 * @brief The stream flags stored in a binary log, each as the bit of its index, so that the log does not depend on how a library numbers them.
+	 */
+	inline const std::ios_base::fmtflags Flags[] = {std::ios_base::boolalpha, std::ios_base::dec, std::ios_base::fixed, std::ios_base::hex, std::ios_base::internal, std::ios_base::left, std::ios_base::oct, std::ios_base::right, std::ios_base::scientific, std::ios_base::showbase, std::ios_base::showpoint, std::ios_base::showpos, std::ios_base::skipws, std::ios_base::unitbuf, std::ios_base::uppercase};
+	/**
+	 * @brief Appends the bytes of `Value` to `Out`.
+	 */
+	template<typename T> void Store(std::string& Out, T Value) {
+		Out.append(reinterpret_cast<const char*>(&Value), sizeof(Value));
+	}
+	/**
+	 * @brief Appends the length of `Value` and its characters, each in 32 bits so that they can be read back as any character type.
+	 */
+	template<typename Text> void StoreText(std::string& Out, Text const& Value) {
+		using CharT = std::remove_cv_t<std::remove_pointer_t<decltype(Value.data())>>;
+		Store(Out, uint32_t(Value.size()));
+		for (size_t Index = 0; Index < Value.size(); ++Index) {
+			Store(Out, uint32_t(std::make_unsigned_t<CharT>(Value.data()[Index])));
+		}
+	}
+
+	template<typename> constexpr bool Unsupported = false;
+
+	/**
+	 * @brief The kind a value of type `T` is stored as.
+	 */
+	template<typename T, size_t I = 0> constexpr uint8_t KindOf() {
+		if constexpr (I < std::tuple_size_v<Scalars>) {
+			if constexpr (std::is_same_v<T, std::tuple_element_t<I, Scalars>>) {
+				return I;
+			}
+			else {
+				return KindOf<T, I + 1>();
+			}
+		}
+		else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+			return Text;
+		}
+		else if constexpr (std::is_convertible_v<T const&, std::wstring_view>) {
+			return WideText;
+		}
+		else {
+			static_assert(Unsupported<T>, "DeferredLog only stores arithmetic types and strings.");
+			return 0;
+		}
+	}
+	/**
+	 * @brief Calls `Function` with a value of the scalar type of kind `Kind`.
+	 */
+	template<size_t I = 0, typename Function> void VisitScalar(uint8_t Kind, Function&& Call) {
+		if constexpr (I < std::tuple_size_v<Scalars>) {
+			if (Kind == I) {
+				Call(std::tuple_element_t<I, Scalars>{});
+			}
+			else {
+				VisitScalar<I + 1>(Kind, Call);
+			}
+		}
+	}
+
+	/**
+	 * @brief The character type of the strings of kind `Kind`.
+	 */
+	template<uint8_t Kind> using CharOf = std::conditional_t<Kind == Text, char, wchar_t>;
+	/**
+	 * @brief The characters of a string, or `nullptr` for a null pointer.
+	 */
+	template<typename CharT, typename T> std::basic_string_view<CharT> View(T const& Value) {
+		if constexpr (std::is_pointer_v<T>) {
+			if (!Value) {
+				return std::basic_string_view<CharT>(nullptr, 0);
+			}
+		}
+		return std::basic_string_view<CharT>(Value);
+	}
+	/**
+	 * @brief The number of bytes holding the value of a `T`, fewer than its size for the x87 `long double`, whose last bytes are padding.
+	 */
+	template<typename T> constexpr size_t ValueSize = std::is_same_v<T, long double> && std::numeric_limits<long double>::digits == 64 ? 10 : sizeof(T);
+	/**
+	 * @brief The number of bytes a value is stored in.
+	 */
+	template<typename T> size_t SizeOf(T const& Value) {
+		constexpr uint8_t Kind = KindOf<T>();
+		if constexpr (Kind < Text) {
+			return sizeof(T);
+		}
+		else {
+			return sizeof(uint32_t) + View<CharOf<Kind>>(Value).size() * sizeof(CharOf<Kind>);
+		}
+	}
+	/**
+	 * @brief Stores a value at `Out`.
+	 * @return The end of the stored bytes.
+	 */
+	template<typename T> char* Encode(char* Out, T const& Value) {
+		constexpr uint8_t Kind = KindOf<T>();
+		if constexpr (Kind < Text) {
+			//Padding is zeroed rather than copied, so that no uninitialised bytes end up in the log.
+			std::memcpy(Out, &Value, ValueSize<T>);
+			std::memset(Out + ValueSize<T>, 0, sizeof(T) - ValueSize<T>);
+			return Out + sizeof(T);
+		}
+		else {
+			const auto Characters = View<CharOf<Kind>>(Value);
+			const uint32_t Length = Characters.data() ? uint32_t(Characters.size()) : NullText;
+			std::memcpy(Out, &Length, sizeof(Length));
+			if (Characters.size()) {
+				std::memcpy(Out + sizeof(Length), Characters.data(), Characters.size() * sizeof(CharOf<Kind>));
+			}
+			return Out + sizeof(Length) + Characters.size() * sizeof(CharOf<Kind>);
+		}
+	}
+
+	/**
+	 * @brief The next free call site id.
+	 */
+	inline std::atomic<uint32_t> NextSite{0};
+	/**
+	 * @brief The id of the call sites keyed by the types `T...`, assigned on first use.
+	 *
+	 * @details DeferredLog::operator()(T const&...) keys a call site by the types of its values alone, so all the calls with the same types share an id, which is all rendering needs. OUTPUTMANAGER_LOG adds the type of a lambda written at the call site, unique to that line of code, so every call site gets its own id. The identity of a call site is fixed at compile time; the number standing for it is handed out on first use, so that the ids of the whole program are small and dense whatever translation unit they are in.
+	 */
+	template<typename... T> uint32_t Site() {
+		static const uint32_t Id = NextSite++;
+		return Id;
+	}
+
+	/**
+	 * @brief The next free thread index.
+	 */
+	inline std::atomic<size_t> NextThread{0};
+	/**
+	 * @brief The index of the calling thread, assigned on first use, which spreads the logging threads over the buffers of a DeferredLog.
+	 */
+	inline size_t ThreadIndex() {
+		thread_local const size_t Index = NextThread++;
+		return Index;
+	}
+}
+
+/**
+ * @brief Turns a binary log written by DeferredLog back into the text OutputManager would have printed.
+ *
+ * @details Values are printed one by one through the same code as operator()(T&&, P&&...), with the settings stored in the log or those of the OutputManager given, so the text is identical to printing them straight away with the same settings. A timestamp, if set, is the time of rendering. The decoder remembers the call sites defined in the log, so a log can be rendered in pieces as long as every piece holds whole records.
+ */
+class DeferredLogDecoder {
+	protected:
+		/**
+		 * @brief The kinds of the values of every call site defined so far, by id.
+		 */
+		std::vector<std::vector<uint8_t>> Sites__;
+		/**
+		 * @brief The strings being printed.
+		 */
+		std::string Narrow__;
+		std::wstring Wide__;
+
+		/**
+		 * @brief Reads `Size` bytes at `Data` into `Value`, moving `Data` on.
+		 * @throw std::runtime_error If the log ends first.
+		 */
+		static void Read__(const char*& Data, const char* End, void* Value, size_t Size) {
+			if (size_t(End - Data) < Size) {
+				throw std::runtime_error("DeferredLog: truncated record");
+			}
+			//A call site without values has no storage, and memcpy must not be given a null pointer even for no bytes.
+			if (Size) {
+				std::memcpy(Value, Data, Size);
+			}
+			Data += Size;
+		}
+		/**
+		 * @brief Reads a string stored by DeferredLogDetail::StoreText(std::string&, Text const&).
+		 * @throw std::runtime_error If the log ends first.
+		 */
+		template<typename CharT> static std::basic_string<CharT> ReadText__(const char*& Data, const char* End) {
+			uint32_t Length;
+			Read__(Data, End, &Length, sizeof(Length));
+			if (size_t(End - Data) / sizeof(uint32_t) < Length) {
+				throw std::runtime_error("DeferredLog: truncated settings");
+			}
+			std::basic_string<CharT> Value(Length, CharT());
+			for (CharT& Character : Value) {
+				uint32_t Code;
+				Read__(Data, End, &Code, sizeof(Code));
+				Character = CharT(Code);
+			}
+			return Value;
+		}
+		/**
+		 * @brief Gives `Manager` the settings stored between `Data` and `End` by DeferredLog(std::ostream&, OutputManager<OutType, StringType> const&, size_t).
+		 * @details Separators fixed by StaticSeparators are kept. Nothing is changed if the settings are truncated or out of range.
+		 * @throw std::runtime_error If the settings are truncated, or the width, base or precision are out of range.
+		 */
+		template<typename OutType, typename StringType> static void Apply__(const char* Data, const char* End, OutputManager<OutType, StringType>& Manager) {
+			using Char__ = typename OutType::char_type;
+			using ColumnFormat__ = OutputManagerDetail::ColumnFormat<Char__>;
+			uint32_t Bits, Fill, Base;
+			int64_t Precision;
+			uint64_t Width;
+			uint8_t BasePad, Timed;
+			Read__(Data, End, &Bits, sizeof(Bits));
+			Read__(Data, End, &Precision, sizeof(Precision));
+			Read__(Data, End, &Fill, sizeof(Fill));
+			Read__(Data, End, &Width, sizeof(Width));
+			Read__(Data, End, &Base, sizeof(Base));
+			Read__(Data, End, &BasePad, sizeof(BasePad));
+			auto Separator = ReadText__<Char__>(Data, End);
+			auto EndOfLine = ReadText__<Char__>(Data, End);
+			uint32_t Count;
+			Read__(Data, End, &Count, sizeof(Count));
+			if (size_t(End - Data) / (2 * sizeof(uint32_t)) < Count) {
+				throw std::runtime_error("DeferredLog: truncated settings");
+			}
+			OutputManagerDetail::OutputBuffer<ColumnFormat__> Columns;
+			Columns.Append(Count, ColumnFormat__{});
+			for (size_t Index = 0; Index < Count; ++Index) {
+				ColumnFormat__& Column = Columns.Data()[Index];
+				uint32_t Grouping;
+				int32_t Units;
+				Read__(Data, End, &Grouping, sizeof(Grouping));
+				Read__(Data, End, &Units, sizeof(Units));
+				Column.Grouping = Char__(Grouping);
+				Column.Units = Units;
+			}
+			Read__(Data, End, &Timed, sizeof(Timed));
+			OutputManagerDetail::Owned<OutputManagerDetail::Timestamp<Char__>> Timestamp;
+			if (Timed) {
+				Timestamp.reset(new OutputManagerDetail::Timestamp<Char__>);
+				Timestamp->Format = ReadText__<char>(Data, End);
+				uint32_t Digits;
+				uint8_t Coarse;
+				Read__(Data, End, &Digits, sizeof(Digits));
+				Read__(Data, End, &Coarse, sizeof(Coarse));
+				Timestamp->Digits = std::min(Digits, 9u);
+				Timestamp->Coarse = Coarse;
+			}
+			if (Width > DeferredLogDetail::MaxWidth || Precision < 0 || Precision > DeferredLogDetail::MaxPrecision || (Base != 2 && Base != 8 && Base != 10 && Base != 16)) {
+				throw std::runtime_error("DeferredLog: settings out of range");
+			}
+			//Nothing is changed until everything has been read and checked.
+			std::ios_base::fmtflags Flags{};
+			for (size_t Index = 0; Index < std::size(DeferredLogDetail::Flags); ++Index) {
+				if (Bits >> Index & 1) {
+					Flags |= DeferredLogDetail::Flags[Index];
+				}
+			}
+			Manager.OutStream__.flags(Flags);
+			Manager.OutStream__.precision(std::streamsize(Precision));
+			Manager.OutStream__.fill(Char__(Fill));
+			Manager.Width__ = size_t(Width);
+			Manager.Base__ = static_cast<unsigned char>(Base);
+			Manager.BasePad__ = BasePad;
+			if constexpr (!OutputManagerDetail::Separators<StringType>::Static) {
+				Manager.Separator__.assign(Separator.begin(), Separator.end());
+				Manager.EndOfLine__.assign(EndOfLine.begin(), EndOfLine.end());
+			}
+			if (Columns.Size() || Timestamp || Manager.Extras__) {
+				auto& Extras = Manager.Extend__();
+				Extras.Columns = std::move(Columns);
+				Extras.Timestamp = std::move(Timestamp);
+			}
+		}
+		/**
+		 * @brief Prints a string of kind `Kind` in a column.
+		 */
+		template<uint8_t Kind, typename OutType, typename StringType> void Text__(const char*& Data, const char* End, size_t Column, OutputManager<OutType, StringType>& Manager) {
+			using CharT = DeferredLogDetail::CharOf<Kind>;
+			using Char__ = typename OutType::char_type;
+			uint32_t Length;
+			Read__(Data, End, &Length, sizeof(Length));
+			if (Length == DeferredLogDetail::NullText) {
+				Manager.Put__(static_cast<const CharT*>(nullptr), Column);
+				return;
+			}
+			std::basic_string<CharT>& Value = [this]() -> std::basic_string<CharT>& {
+				if constexpr (std::is_same_v<CharT, char>) {
+					return Narrow__;
+				}
+				else {
+					return Wide__;
+				}
+			}();
+			if (size_t(End - Data) / sizeof(CharT) < Length) {
+				throw std::runtime_error("DeferredLog: truncated record");
+			}
+			Value.resize(Length);
+			Read__(Data, End, &Value[0], Length * sizeof(CharT));
+			if constexpr (std::is_same_v<CharT, Char__>) {
+				Manager.Put__(Value, Column);
+			}
+			else if constexpr (std::is_same_v<CharT, char>) {
+				//Narrow strings reach wide streams through operator<<, like a `const char*` would.
+				Manager.Put__(Value.c_str(), Column);
+			}
+			else {
+				throw std::runtime_error("DeferredLog: wide strings cannot be printed to a narrow stream");
+			}
+		}
+
+		/**
+		 * @brief Moves `Data` past the values of kinds `Kinds`.
+		 * @throw std::runtime_error If the log ends first.
+		 */
+		static void Skip__(const char*& Data, const char* End, std::vector<uint8_t> const& Kinds) {
+			for (const uint8_t Kind : Kinds) {
+				size_t Size = 0;
+				if (Kind < DeferredLogDetail::Text) {
+					DeferredLogDetail::VisitScalar(Kind, [&](auto Value) {
+						Size = sizeof(Value);
+					});
+				}
+				else {
+					uint32_t Length;
+					Read__(Data, End, &Length, sizeof(Length));
+					if (Length != DeferredLogDetail::NullText) {
+						Size = size_t(Length) * (Kind == DeferredLogDetail::Text ? sizeof(char) : sizeof(wchar_t));
+					}
+				}
+				if (size_t(End - Data) < Size) {
+					throw std::runtime_error("DeferredLog: truncated record");
+				}
+				Data += Size;
+			}
+		}
+
+	public:
+		/**
+		 * @brief Prints the records between `Begin` and `End`, which must not include the start of a log, with `Manager`.
+		 * @details A line that cannot be printed is left out, and the first exception is rethrown once the other records are done, so no call site definition is lost.
+		 * @throw std::runtime_error If a record is truncated or logs an unknown call site.
+		 * @throw Whatever printing a line threw.
+		 */
+		template<typename OutType, typename StringType> void Render(const char* Begin, const char* End, OutputManager<OutType, StringType>& Manager);
+		/**
+		 * @brief Prints a whole binary log, as written by DeferredLog(std::ostream&, size_t), with `Manager`.
+		 * @details If the log was written by DeferredLog(std::ostream&, OutputManager<OutType, StringType> const&, size_t), `Manager` first gets the settings stored in it, except for separators fixed by StaticSeparators.
+		 * @throw std::runtime_error If the log is not a binary log written on a platform with the same sizes and byte order, or is corrupted.
+		 */
+		template<typename OutType, typename StringType> void Decode(std::istream& Binary, OutputManager<OutType, StringType>& Manager);
+};
+
+/**
+ * @brief Logs values without formatting them, leaving the formatting to a background thread or to an offline DeferredLogDecoder.
+ *
+ * @details operator()(T const&...) stores the raw bytes of its arguments after the id of its call site in a buffer, which is the only work done by the calling thread. A background thread sleeps until a line is logged, then takes the buffers within a few milliseconds, or as soon as they hold `BatchSize` bytes or Flush() is called, and either renders them with the settings an OutputManager had when the log was created, or appends them to a binary stream for DeferredLogDecoder. The text is the same that OutputManager::operator()(T&&, P&&...) would have printed.
+ * @details Only arithmetic types and strings can be logged, strings are copied. Any number of threads can log at once, each call is a single line. Threads are spread over a few buffers with a lock each, so they seldom wait for one another: the lines of one thread keep their order, but the lines of different threads may come out in another order than the one they were logged in.
+ * @details The bytes logged and not yet rendered or written are bounded, see SetCapacity(size_t, bool). When the log is full, a logging thread either waits for the background thread to catch up, which is the default, or drops its line.
+ *
+ * **Example:**
+ * ```.cpp
+ * #include "DeferredLog.h"
+ * #include "OutputManagerConsole.h"
+ *
+ * int main () {
+ *     OutputManager O;
+ *     O.SetPrecision(3);
+ *     DeferredLog Log(O);
+ *     for (int i = 0; i < 1000000; ++i) {
+ *         Log(i, L"squared is", double(i) * i);
+ *     }
+ * }
+ * ```
+ * @warning When rendering, the OutputManager and its stream must not print anything else until the DeferredLog is destroyed or Flush() returns, and the settings are those at creation. A timestamp set with OutputManager::SetTimestamp(std::string const&, unsigned, bool) is the time of rendering, not of logging. A binary log can only be decoded on a platform with the same sizes and byte order.
+ * @warning If rendering a line throws, that line is left out, and if writing a buffer throws, the rest of that buffer is lost. The first exception is rethrown by the next Flush() or by Close(). The destructor never throws, so an exception neither of them rethrew is lost.
+ */
+class DeferredLog {
+	protected:
+		/**
+		 * @brief A buffer filled by some of the logging threads, with its lock and the call sites defined in it so far, by id.
+		 *
+		 * @details Every buffer defines its own call sites, so that it can be rendered whatever the order the buffers are taken in.
+		 */
+		struct alignas(64) Shard__ {
+			std::mutex Lock;
+			OutputManagerDetail::OutputBuffer<char> Front;
+			std::vector<bool> Defined;
+		};
+		/**
+		 * @brief The buffers filled by the logging threads.
+		 */
+		std::array<Shard__, 8> Shards__;
+		/**
+		 * @brief The buffer taken by the background thread.
+		 */
+		OutputManagerDetail::OutputBuffer<char> Back__;
+		/**
+		 * @brief Guards the flags and the error below.
+		 */
+		std::mutex Lock__;
+		/**
+		 * @brief Wakes the background thread, Flush() once a pass is done, and the logging threads waiting for room.
+		 */
+		std::condition_variable Wake__, Done__, Room__;
+		/**
+		 * @brief The number of bytes logged and not yet rendered or written.
+		 */
+		std::atomic<size_t> Pending__{0};
+		/**
+		 * @brief The number of lines dropped because the log was full.
+		 */
+		std::atomic<size_t> Dropped__{0};
+		/**
+		 * @brief The size at which the buffers are handed over right away.
+		 */
+		size_t Batch__;
+		/**
+		 * @brief The maximum number of pending bytes.
+		 */
+		size_t Capacity__ = size_t(1) << 26;
+		/**
+		 * @brief `true` if lines that do not fit are dropped, `false` if the logging threads wait.
+		 */
+		bool Drop__ = false;
+		/**
+		 * @brief `true` when the background thread must hand over the buffers right away, or stop.
+		 */
+		bool Urgent__ = false, Stop__ = false;
+		/**
+		 * @brief The number of passes over the buffers the background thread started and finished.
+		 *
+		 * @details A pass started after a line was logged takes it, so Flush() waits for the pass after the current one instead of waiting for the log to be empty, which it may never be while other threads log.
+		 */
+		uint64_t Started__ = 0, Finished__ = 0;
+		/**
+		 * @brief The first exception thrown while consuming a buffer, until it is rethrown.
+		 */
+		std::exception_ptr Error__;
+		/**
+		 * @brief Renders or writes a buffer, on the background thread.
+		 */
+		std::function<void(const char*, const char*)> Consume__;
+		/**
+		 * @brief The background thread.
+		 */
+		std::thread Worker__;
+
+		/**
+		 * @brief Hands the buffers over and consumes them, until stopped.
+		 * @details Sleeps on `Wake__` while nothing is logged. The first line logged wakes it, and the lines then have at most 10 ms to fill a batch before the buffers are taken, unless a full batch, Flush(), a full log or the end of the log wakes it sooner.
+		 */
+		void Run__() {
+			std::unique_lock<std::mutex> Guard(Lock__);
+			while (true) {
+				Wake__.wait(Guard, [this]() {
+					return Stop__ || Urgent__ || Pending__;
+				});
+				Wake__.wait_for(Guard, std::chrono::milliseconds(10), [this]() {
+					return Stop__ || Urgent__ || Pending__ >= Batch__;
+				});
+				Urgent__ = false;
+				const uint64_t Pass = ++Started__;
+				Guard.unlock();
+				std::exception_ptr Failed;
+				for (Shard__& Shard : Shards__) {
+					{
+						std::lock_guard<std::mutex> ShardGuard(Shard.Lock);
+						std::swap(Shard.Front, Back__);
+					}
+					if (Back__.Size()) {
+						try {
+							Consume__(Back__.Data(), Back__.Data() + Back__.Size());
+						}
+						catch (...) {
+							if (!Failed) {
+								Failed = std::current_exception();
+							}
+						}
+						Pending__ -= Back__.Size();
+						Back__.Clear();
+					}
+				}
+				Guard.lock();
+				if (Failed && !Error__) {
+					Error__ = Failed;
+				}
+				Finished__ = Pass;
+				Room__.notify_all();
+				Done__.notify_all();
+				if (Stop__ && !Pending__) {
+					return;
+				}
+			}
+		}
+		/**
+		 * @brief Counts `Size` more bytes as pending, waiting for room or giving up if the log is full.
+		 * @return `false` if the line must be dropped.
+		 */
+		bool Reserve__(size_t Size) {
+			size_t Held = Pending__.load();
+			do {
+				//A line longer than the capacity still goes through alone.
+				if (Held && Held + Size > Capacity__) {
+					if (Drop__) {
+						++Dropped__;
+						return false;
+					}
+					std::unique_lock<std::mutex> Guard(Lock__);
+					Urgent__ = true;
+					Wake__.notify_one();
+					Room__.wait(Guard, [&]() {
+						Held = Pending__.load();
+						return !Held || Held + Size <= Capacity__;
+					});
+				}
+			} while (!Pending__.compare_exchange_weak(Held, Held + Size));
+			//Taking the lock orders the notification after the wait of the background thread, so it cannot be lost.
+			if (!Held || (Held < Batch__ && Held + Size >= Batch__)) {
+				std::lock_guard<std::mutex> Guard(Lock__);
+				Wake__.notify_one();
+			}
+			return true;
+		}
+		/**
+		 * @brief Logs one line holding all the given values under the call site id `Site`.
+		 */
+		template<typename... T> void Log__(uint32_t Site, T const&... Elements);
+		/**
+		 * @brief Defines the call site `Site` for the types `T...` in the buffer of `Shard`.
+		 * @warning The lock of `Shard` must be held.
+		 */
+		template<typename... T> void Define__(Shard__& Shard, uint32_t Site) {
+			static constexpr std::array<uint8_t, sizeof...(T)> Kinds{DeferredLogDetail::KindOf<T>()...};
+			if (Shard.Defined.size() <= Site) {
+				Shard.Defined.resize(Site + 1);
+			}
+			Shard.Defined[Site] = true;
+			const uint32_t Word = Site | DeferredLogDetail::Definition;
+			const uint8_t Count = sizeof...(T);
+			char* Out = Shard.Front.Reserve(sizeof(Word) + 1 + Count);
+			std::memcpy(Out, &Word, sizeof(Word));
+			Out[sizeof(Word)] = char(Count);
+			std::memcpy(Out + sizeof(Word) + 1, Kinds.data(), Count);
+			Shard.Front.Commit(Out + sizeof(Word) + 1 + Count);
+			Pending__ += sizeof(Word) + 1 + Count;
+		}
+		/**
+		 * @brief Starts the background thread.
+		 */
+		void Start__() {
+			Worker__ = std::thread(&DeferredLog::Run__, this);
+		}
+		/**
+		 * @brief Stops the background thread once everything is consumed, if it is still running.
+		 */
+		void Join__() {
+			if (!Worker__.joinable()) {
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> Guard(Lock__);
+				Stop__ = true;
+			}
+			Wake__.notify_one();
+			Worker__.join();
+		}
+		/**
+		 * @brief Writes the start of a binary log with the given settings to `Binary`, and starts appending the buffers to it in the background.
+		 */
+		void Open__(std::ostream& Binary, std::string const& Settings) {
+			const uint32_t Length = uint32_t(Settings.size());
+			Binary.write(DeferredLogDetail::Magic, sizeof(DeferredLogDetail::Magic));
+			Binary.put(char(DeferredLogDetail::Version));
+			Binary.write(reinterpret_cast<const char*>(DeferredLogDetail::Sizes), sizeof(DeferredLogDetail::Sizes));
+			Binary.write(reinterpret_cast<const char*>(&DeferredLogDetail::ByteOrder), sizeof(DeferredLogDetail::ByteOrder));
+			Binary.write(reinterpret_cast<const char*>(&Length), sizeof(Length));
+			Binary.write(Settings.data(), Settings.size());
+			Consume__ = [&Binary](const char* Begin, const char* End) {
+				Binary.write(Begin, End - Begin);
+				Binary.flush();
+			};
+			Start__();
+		}
+		/**
+		 * @brief The settings of `Manager` which change the text of a line, as stored in a binary log.
+		 */
+		template<typename OutType, typename StringType> static std::string Settings__(OutputManager<OutType, StringType> const& Manager) {
+			std::string Settings;
+			const std::ios_base::fmtflags Flags = Manager.OutStream__.flags();
+			uint32_t Bits = 0;
+			for (size_t Index = 0; Index < std::size(DeferredLogDetail::Flags); ++Index) {
+				if ((Flags & DeferredLogDetail::Flags[Index]) == DeferredLogDetail::Flags[Index]) {
+					Bits |= uint32_t(1) << Index;
+				}
+			}
+			DeferredLogDetail::Store(Settings, Bits);
+			DeferredLogDetail::Store(Settings, int64_t(Manager.OutStream__.precision()));
+			DeferredLogDetail::Store(Settings, uint32_t(std::make_unsigned_t<typename OutType::char_type>(Manager.OutStream__.fill())));
+			DeferredLogDetail::Store(Settings, uint64_t(Manager.Width__));
+			DeferredLogDetail::Store(Settings, uint32_t(Manager.Base__));
+			DeferredLogDetail::Store(Settings, uint8_t(Manager.BasePad__));
+			DeferredLogDetail::StoreText(Settings, Manager.Separator__);
+			DeferredLogDetail::StoreText(Settings, Manager.EndOfLine__);
+			const auto* Columns = Manager.Extras__ ? &Manager.Extras__->Columns : nullptr;
+			DeferredLogDetail::Store(Settings, uint32_t(Columns ? Columns->Size() : 0));
+			for (auto Column = Columns ? Columns->Data() : nullptr; Columns && Column != Columns->Data() + Columns->Size(); ++Column) {
+				DeferredLogDetail::Store(Settings, uint32_t(std::make_unsigned_t<typename OutType::char_type>(Column->Grouping)));
+				DeferredLogDetail::Store(Settings, int32_t(Column->Units));
+			}
+			const auto* Stamp = Manager.Timestamp__();
+			DeferredLogDetail::Store(Settings, uint8_t(bool(Stamp)));
+			if (Stamp) {
+				DeferredLogDetail::StoreText(Settings, Stamp->Format);
+				DeferredLogDetail::Store(Settings, uint32_t(Stamp->Digits));
+				DeferredLogDetail::Store(Settings, uint8_t(Stamp->Coarse));
+			}
+			return Settings;
+		}
+
+	public:
+		DeferredLog(DeferredLog const&) = delete;
+		DeferredLog& operator=(DeferredLog const&) = delete;
+
+		/**
+		 * @brief Renders the log in the background to the stream of `Manager`, with the settings it has now.
+		 * @param BatchSize The number of bytes after which the background thread takes the buffers without waiting.
+		 */
+		template<typename OutType, typename StringType> explicit DeferredLog(OutputManager<OutType, StringType>& Manager, size_t BatchSize = 1 << 16);
+		/**
+		 * @brief Writes the log in the background to `Binary`, to be decoded later by DeferredLogDecoder::Decode(std::istream&, OutputManager<OutType, StringType>&) with the settings of the decoding OutputManager.
+		 * @param BatchSize The number of bytes after which the background thread takes the buffers without waiting.
+		 */
+		explicit DeferredLog(std::ostream& Binary, size_t BatchSize = 1 << 16);
+		/**
+		 * @brief Writes the log in the background to `Binary` like DeferredLog(std::ostream&, size_t), storing the settings `Settings` has now, which DeferredLogDecoder::Decode(std::istream&, OutputManager<OutType, StringType>&) applies.
+		 * @details A width or precision above DeferredLogDetail::MaxWidth or DeferredLogDetail::MaxPrecision is stored, but the decoder skips such settings.
+		 * @param BatchSize The number of bytes after which the background thread takes the buffers without waiting.
+		 */
+		template<typename OutType, typename StringType> DeferredLog(std::ostream& Binary, OutputManager<OutType, StringType> const& Settings, size_t BatchSize = 1 << 16);
+		/**
+		 * @brief Renders or writes whatever is left, like Close(), but drops any exception.
+		 */
+		~DeferredLog();
+
+		/**
+		 * @brief Logs one line holding all the given values, sharing its call site id with every call logging the same types.
+		 * @details If the log is full, waits for room or drops the line, see SetCapacity(size_t, bool).
+		 * @tparam T Arithmetic types and strings.
+		 * @throw std::runtime_error If the program logs more than 65536 different lists of types and call sites.
+		 */
+		template<typename... T> void operator()(T const&... Elements);
+		/**
+		 * @brief Logs one line holding all the given values like operator()(T const&...), with the call site id of `Tag`.
+		 * @details OUTPUTMANAGER_LOG passes a lambda written at the call site, so that every call site has its own id.
+		 * @tparam Tag A type unique to the call site.
+		 * @throw std::runtime_error If the program logs more than 65536 different lists of types and call sites.
+		 */
+		template<typename Tag, typename... T> void LogAt(Tag, T const&... Elements);
+		/**
+		 * @brief Waits until everything logged before the call has been rendered or written, then flushes the stream.
+		 * @details Does not wait for the lines other threads log meanwhile, so it returns even if they never stop.
+		 * @throw Whatever rendering or writing threw since the last call, if anything.
+		 */
+		void Flush();
+		/**
+		 * @brief Renders or writes whatever is left and stops the background thread. Nothing can be logged afterwards.
+		 * @warning No other thread may log or flush meanwhile.
+		 * @throw Whatever rendering or writing threw and no Flush() rethrew, if anything.
+		 */
+		void Close();
+		/**
+		 * @brief Sets how many bytes can be logged and not yet rendered or written.
+		 * @details A line that does not fit waits until the background thread has made room, or is dropped and counted by Dropped(). A line longer than `Bytes` is only logged when nothing else is pending. Call site definitions, a few bytes each time a call site is first used by a buffer, can go past the capacity. Must be called before logging.
+		 * @param Bytes The capacity, 64 MiB by default.
+		 * @param Drop `true` to drop the lines that do not fit, `false` to wait.
+		 */
+		void SetCapacity(size_t Bytes, bool Drop = false);
+		/**
+		 * @brief The number of lines dropped because the log was full.
+		 */
+		size_t Dropped() const;
+};
+
+//
+//CONSTRUCTORS
+//
+template<typename OutType, typename StringType>
+DeferredLog ::DeferredLog(OutputManager<OutType, StringType>& Manager, size_t BatchSize) : Batch__{BatchSize} {
+	using Stream__ = std::basic_ostream<typename OutType::char_type, typename OutType::traits_type>;
+	//The renderer shares the stream buffer, but keeps its own formatting state.
+	struct Renderer {
+		Stream__ Stream;
+		OutputManager<Stream__, StringType> Manager;
+		DeferredLogDecoder Decoder;
+		Renderer(OutputManager<OutType, StringType> const& Source) : Stream(Source.OutStream__.rdbuf()), Manager(Stream) {
+			Source.CopySettingsTo__(Manager);
+		}
+	};
+	auto Target = std::make_shared<Renderer>(Manager);
+	Consume__ = [Target](const char* Begin, const char* End) {
+		try {
+			Target->Decoder.Render(Begin, End, Target->Manager);
+		}
+		catch (...) {
+			//Half a line must not end up in front of the next buffer.
+			Target->Manager.Buffer__.Clear();
+			throw;
+		}
+		Target->Stream.flush();
+	};
+	Start__();
+}
+
+inline DeferredLog ::DeferredLog(std::ostream& Binary, size_t BatchSize) : Batch__{BatchSize} {
+	Open__(Binary, std::string());
+}
+
+template<typename OutType, typename StringType>
+DeferredLog ::DeferredLog(std::ostream& Binary, OutputManager<OutType, StringType> const& Settings, size_t BatchSize) : Batch__{BatchSize} {
+	Open__(Binary, Settings__(Settings));
+}
+
+inline DeferredLog ::~DeferredLog() {
+	Join__();
+}
+
+//
+//LOGGING
+//
+template<typename... T>
+void DeferredLog ::operator()(T const&... Elements) {
+	Log__(DeferredLogDetail::Site<std::decay_t<T const>...>(), Elements...);
+}
+
+template<typename Tag, typename... T>
+void DeferredLog ::LogAt(Tag, T const&... Elements) {
+	Log__(DeferredLogDetail::Site<Tag, std::decay_t<T const>...>(), Elements...);
+}
+
+template<typename... T>
+void DeferredLog ::Log__(uint32_t Site, T const&... Elements) {
+	if (Site >= DeferredLogDetail::MaxSites) {
+		throw std::runtime_error("DeferredLog: too many call sites");
+	}
+	const size_t Size = sizeof(Site) + (size_t(0) + ... + DeferredLogDetail::SizeOf<std::decay_t<T const>>(Elements));
+	if (!Reserve__(Size)) {
+		return;
+	}
+	Shard__& Shard = Shards__[DeferredLogDetail::ThreadIndex() % Shards__.size()];
+	std::lock_guard<std::mutex> Guard(Shard.Lock);
+	if (Site >= Shard.Defined.size() || !Shard.Defined[Site]) {
+		Define__<std::decay_t<T const>...>(Shard, Site);
+	}
+	char* Out = Shard.Front.Reserve(Size);
+	std::memcpy(Out, &Site, sizeof(Site));
+	Out += sizeof(Site);
+	((Out = DeferredLogDetail::Encode<std::decay_t<T const>>(Out, Elements)),...);
+	Shard.Front.Commit(Out);
+}
+
+inline void DeferredLog ::Flush() {
+	std::unique_lock<std::mutex> Guard(Lock__);
+	if (!Worker__.joinable()) {
+		Guard.unlock();
+		Close();
+		return;
+	}
+	//The next pass starts after this call, so it takes every line logged before it.
+	const uint64_t Pass = Started__ + 1;
+	Urgent__ = true;
+	Wake__.notify_one();
+	Done__.wait(Guard, [&]() {
+		return Finished__ >= Pass;
+	});
+	if (Error__) {
+		const std::exception_ptr Failed = Error__;
+		Error__ = nullptr;
+		std::rethrow_exception(Failed);
+	}
+}
+
+inline void DeferredLog ::Close() {
+	Join__();
+	if (Error__) {
+		const std::exception_ptr Failed = Error__;
+		Error__ = nullptr;
+		std::rethrow_exception(Failed);
+	}
+}
+
+inline void DeferredLog ::SetCapacity(size_t Bytes, bool Drop) {
+	Capacity__ = Bytes;
+	Drop__ = Drop;
+}
+
+inline size_t DeferredLog ::Dropped() const {
+	return Dropped__;
+}
+
+//
+//DECODING
+//
+template<typename OutType, typename StringType>
+void DeferredLogDecoder ::Render(const char* Begin, const char* End, OutputManager<OutType, StringType>& Manager) {
+	Manager.Refresh__();
+	std::exception_ptr Failed;
+	while (Begin != End) {
+		uint32_t Word;
+		Read__(Begin, End, &Word, sizeof(Word));
+		if (Word & DeferredLogDetail::Definition) {
+			const uint32_t Site = Word & ~DeferredLogDetail::Definition;
+			uint8_t Count;
+			Read__(Begin, End, &Count, 1);
+			if (Site >= DeferredLogDetail::MaxSites) {
+				throw std::runtime_error("DeferredLog: call site " + std::to_string(Site) + " out of range");
+			}
+			if (Sites__.size() <= Site) {
+				Sites__.resize(Site + 1);
+			}
+			Sites__[Site].resize(Count);
+			Read__(Begin, End, Sites__[Site].data(), Count);
+			continue;
+		}
+		if (Word >= Sites__.size()) {
+			throw std::runtime_error("DeferredLog: unknown call site " + std::to_string(Word));
+		}
+		//The end of the record is found first, so that a line which fails can be skipped.
+		const char* Next = Begin;
+		Skip__(Next, End, Sites__[Word]);
+		const size_t Mark = Manager.Buffer__.Size();
+		try {
+			if (!Sites__[Word].empty()) {
+				Manager.StartLine__();
+			}
+			size_t Column = 0;
+			for (const uint8_t Kind : Sites__[Word]) {
+				if (Column) {
+					Manager.Append__(Manager.Separator__);
+				}
+				if (Kind < DeferredLogDetail::Text) {
+					DeferredLogDetail::VisitScalar(Kind, [&](auto Value) {
+						Read__(Begin, End, &Value, sizeof(Value));
+						Manager.Put__(Value, Column);
+					});
+				}
+				else if (Kind == DeferredLogDetail::Text) {
+					Text__<DeferredLogDetail::Text>(Begin, End, Column, Manager);
+				}
+				else {
+					Text__<DeferredLogDetail::WideText>(Begin, End, Column, Manager);
+				}
+				Manager.Drain__();
+				++Column;
+			}
+			Manager.Append__(Manager.EndOfLine__);
+		}
+		catch (...) {
+			//Half a line must not be printed.
+			Manager.Buffer__.Truncate(Mark);
+			if (!Failed) {
+				Failed = std::current_exception();
+			}
+			Begin = Next;
+			continue;
+		}
+		if (Manager.Buffer__.Size() >= Manager.BlockLength__(1)) {
+			Manager.Flush__();
+		}
+	}
+	Manager.Flush__();
+	if (Failed) {
+		std::rethrow_exception(Failed);
+	}
+}
+
+template<typename OutType, typename StringType>
+void DeferredLogDecoder ::Decode(std::istream& Binary, OutputManager<OutType, StringType>& Manager) {
+	const std::string Log{std::istreambuf_iterator<char>(Binary), std::istreambuf_iterator<char>()};
+	const size_t Start = sizeof(DeferredLogDetail::Magic) + 1 + sizeof(DeferredLogDetail::Sizes) + sizeof(DeferredLogDetail::ByteOrder);
+	uint32_t Order;
+	if (Log.size() < Start || std::memcmp(Log.data(), DeferredLogDetail::Magic, sizeof(DeferredLogDetail::Magic)) || uint8_t(Log[sizeof(DeferredLogDetail::Magic)]) != DeferredLogDetail::Version) {
+		throw std::runtime_error("DeferredLog: not a binary log");
+	}
+	std::memcpy(&Order, Log.data() + Start - sizeof(Order), sizeof(Order));
+	if (std::memcmp(Log.data() + sizeof(DeferredLogDetail::Magic) + 1, DeferredLogDetail::Sizes, sizeof(DeferredLogDetail::Sizes)) || Order != DeferredLogDetail::ByteOrder) {
+		throw std::runtime_error("DeferredLog: the log was written on a platform with different sizes or byte order");
+	}
+	const char* Data = Log.data() + Start;
+	const char* End = Log.data() + Log.size();
+	uint32_t Length;
+	Read__(Data, End, &Length, sizeof(Length));
+	if (size_t(End - Data) < Length) {
+		throw std::runtime_error("DeferredLog: truncated settings");
+	}
+	//Settings which cannot be applied are skipped, the lines are still rendered with those of `Manager`.
+	std::exception_ptr Failed;
+	if (Length) {
+		try {
+			Apply__(Data, Data + Length, Manager);
+		}
+		catch (std::runtime_error const&) {
+			Failed = std::current_exception();
+		}
+	}
+	Render(Data + Length, End, Manager);
+	if (Failed) {
+		std::rethrow_exception(Failed);
+	}
+}
+
+#endif
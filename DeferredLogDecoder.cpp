@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @brief Renders a binary log written by DeferredLog with the settings stored in it, or the default settings of OutputManager if it has none.
+ *
+ * @details Usage: `DeferredLogDecoder [-w] Log [File]`, writing to the standard output if no file is given. Logs holding wide strings need `-w`, which renders them with a wide OutputManager. Programs that log without storing their settings can do the same with their own OutputManager and DeferredLogDecoder::Decode(std::istream&, OutputManager<OutType, StringType>&).
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "DeferredLog.h"
+#include "OutputManagerConsole.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <exception>
+
+namespace {
+	/**
+	 * @brief Renders `Binary` to `Output`, or to the standard output if it is `nullptr`.
+	 * @return The exit code.
+	 */
+	template<typename CharT> int Render(std::istream& Binary, const char* Output) {
+		std::basic_ofstream<CharT> File;
+		if (Output) {
+			File.open(Output, std::ios::binary);
+			if (!File) {
+				std::cerr << "Cannot open " << Output << '\n';
+				return 1;
+			}
+		}
+		std::basic_ostream<CharT>& Stream = Output ? File : OutputManagerDetail::StandardStream<std::basic_ostream<CharT>>::Get();
+		OutputManager<std::basic_ostream<CharT>, std::basic_string<CharT>> Manager(Stream);
+		DeferredLogDecoder Decoder;
+		Decoder.Decode(Binary, Manager);
+		return 0;
+	}
+}
+
+int main(int argc, char** argv) {
+	const bool Wide = argc > 1 && std::string(argv[1]) == "-w";
+	if (argc - Wide < 2 || argc - Wide > 3) {
+		std::cerr << "Usage: " << argv[0] << " [-w] Log [File]\n";
+		return 2;
+	}
+	const char* Input = argv[1 + Wide];
+	const char* Output = argc - Wide == 3 ? argv[2 + Wide] : nullptr;
+	std::ifstream Binary(Input, std::ios::binary);
+	if (!Binary) {
+		std::cerr << "Cannot open " << Input << '\n';
+		return 1;
+	}
+	try {
+		return Wide ? Render<wchar_t>(Binary, Output) : Render<char>(Binary, Output);
+	}
+	catch (std::exception const& Error) {
+		std::cerr << Error.what() << '\n';
+		return 1;
+	}
+}
@@ -0,0 +1,839 @@
+#ifndef INPUTMANAGER_H
+#define INPUTMANAGER_H
+
+/**
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "OutputManagerParallel.h"
+#include "OutputManagerSimd.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstring>
+#include <locale>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <functional>
+#include <algorithm>
+#include <cerrno>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief Customisation point to read a type from a field of text, the counterpart of OutputFormatter.
+ *
+ * @details The primary template is empty, so only numbers, characters and strings can be read by default. A specialisation must provide `static bool parse(const char* Begin, const char* End, T& Value)`, which reads the whole field between `Begin` and `End` into `Value` and returns `false` if it is malformed.
+ *
+ * **Example:**
+ * ```.cpp
+ * struct Point {int X, Y;};
+ *
+ * template<> struct InputParser<Point> {
+ *     static bool parse(const char* Begin, const char* End, Point& P) {
+ *         return std::sscanf(std::string(Begin, End).c_str(), "(%d,%d)", &P.X, &P.Y) == 2;
+ *     }
+ * };
+ * ```
+ * @tparam T The type to read.
+ */
+template<typename T> struct InputParser {};
+
+/**
+ * @brief Implementation details of `InputManager`.
+ */
+namespace InputManagerDetail {
+	/**
+	 * @brief Tells if `InputParser<T>` is specialised.
+	 */
+	template<typename T, typename = void> struct HasInputParser : std::false_type {};
+	template<typename T> struct HasInputParser<T, std::void_t<decltype(InputParser<T>::parse(std::declval<const char*>(), std::declval<const char*>(), std::declval<T&>()))>> : std::true_type {};
+
+	/**
+	 * @brief Finds the first of three characters, one character at a time.
+	 * @return The first character between `Begin` and `End` equal to `A`, `B` or `C`, or `End` if there is none.
+	 */
+	inline const char* FindAnyScalar(const char* Begin, const char* End, char A, char B, char C) {
+		for (; Begin != End; ++Begin) {
+			if (*Begin == A || *Begin == B || *Begin == C) {
+				return Begin;
+			}
+		}
+		return End;
+	}
+#if defined(OUTPUTMANAGER_DISPATCH)
+	/**
+	 * @brief FindAnyScalar() comparing sixteen characters at once.
+	 */
+	__attribute__((target("sse2"))) inline const char* FindAnySse2(const char* Begin, const char* End, char A, char B, char C) {
+		const __m128i RepeatedA = _mm_set1_epi8(A);
+		const __m128i RepeatedB = _mm_set1_epi8(B);
+		const __m128i RepeatedC = _mm_set1_epi8(C);
+		for (; End - Begin >= 16; Begin += 16) {
+			const __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Begin));
+			const __m128i Found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Block, RepeatedA), _mm_cmpeq_epi8(Block, RepeatedB)), _mm_cmpeq_epi8(Block, RepeatedC));
+			if (const int Mask = _mm_movemask_epi8(Found)) {
+				return Begin + __builtin_ctz(Mask);
+			}
+		}
+		return FindAnyScalar(Begin, End, A, B, C);
+	}
+	/**
+	 * @brief FindAnyScalar() comparing thirty-two characters at once.
+	 */
+	__attribute__((target("avx2"))) inline const char* FindAnyAvx2(const char* Begin, const char* End, char A, char B, char C) {
+		const __m256i RepeatedA = _mm256_set1_epi8(A);
+		const __m256i RepeatedB = _mm256_set1_epi8(B);
+		const __m256i RepeatedC = _mm256_set1_epi8(C);
+		for (; End - Begin >= 32; Begin += 32) {
+			const __m256i Block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Begin));
+			const __m256i Found = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(Block, RepeatedA), _mm256_cmpeq_epi8(Block, RepeatedB)), _mm256_cmpeq_epi8(Block, RepeatedC));
+			if (const unsigned Mask = _mm256_movemask_epi8(Found)) {
+				return Begin + __builtin_ctz(Mask);
+			}
+		}
+		return FindAnySse2(Begin, End, A, B, C);
+	}
+	/**
+	 * @brief FindAnyScalar() comparing sixty-four characters at once.
+	 */
+	__attribute__((target("avx512bw"))) inline const char* FindAnyAvx512(const char* Begin, const char* End, char A, char B, char C) {
+		const __m512i RepeatedA = _mm512_set1_epi8(A);
+		const __m512i RepeatedB = _mm512_set1_epi8(B);
+		const __m512i RepeatedC = _mm512_set1_epi8(C);
+		for (; End - Begin >= 64; Begin += 64) {
+			const __m512i Block = _mm512_loadu_si512(Begin);
+			if (const __mmask64 Mask = _mm512_cmpeq_epi8_mask(Block, RepeatedA) | _mm512_cmpeq_epi8_mask(Block, RepeatedB) | _mm512_cmpeq_epi8_mask(Block, RepeatedC)) {
+				return Begin + __builtin_ctzll(Mask);
+			}
+		}
+		return FindAnyAvx2(Begin, End, A, B, C);
+	}
+#endif
+	/**
+	 * @brief Finds the first of three characters.
+	 *
+	 * @details Uses the widest of FindAnyAvx512(), FindAnyAvx2(), FindAnySse2() and FindAnyScalar() supported by OutputManagerDetail::Cpu(), bound on the first call.
+	 * @return The first character between `Begin` and `End` equal to `A`, `B` or `C`, or `End` if there is none.
+	 */
+	inline const char* FindAny(const char* Begin, const char* End, char A, char B, char C) {
+		using Kernel = const char* (*)(const char*, const char*, char, char, char);
+		static const Kernel Bound = []() -> Kernel {
+#if defined(OUTPUTMANAGER_DISPATCH)
+			if (OutputManagerDetail::Cpu().Avx512bw) {
+				return FindAnyAvx512;
+			}
+			if (OutputManagerDetail::Cpu().Avx2) {
+				return FindAnyAvx2;
+			}
+			if (OutputManagerDetail::Cpu().Sse2) {
+				return FindAnySse2;
+			}
+#endif
+			return FindAnyScalar;
+		}();
+		return Bound(Begin, End, A, B, C);
+	}
+
+	/**
+	 * @brief A read-only view of a whole file, memory mapped where possible.
+	 *
+	 * @details On POSIX systems the file is mapped with `mmap`, elsewhere it is read into memory.
+	 */
+	class MappedFile {
+		private:
+			const char* Data__ = nullptr;
+			size_t Size__ = 0;
+			std::string Copy__;
+
+		public:
+			MappedFile(MappedFile const&) = delete;
+			MappedFile& operator=(MappedFile const&) = delete;
+
+			/**
+			 * @brief Maps the file at `Path`.
+			 * @throw std::system_error If the file cannot be opened or mapped.
+			 */
+			explicit MappedFile(std::string const& Path) {
+#if defined(__unix__) || defined(__APPLE__)
+				const int FileDescriptor = open(Path.c_str(), O_RDONLY);
+				if (FileDescriptor < 0) {
+					throw std::system_error(errno, std::generic_category(), "InputManager: cannot open " + Path);
+				}
+				struct stat Status;
+				if (fstat(FileDescriptor, &Status) < 0) {
+					const int Error = errno;
+					close(FileDescriptor);
+					throw std::system_error(Error, std::generic_category(), "InputManager: cannot stat " + Path);
+				}
+				Size__ = Status.st_size;
+				if (Size__) {
+					void* Map = mmap(nullptr, Size__, PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+					if (Map == MAP_FAILED) {
+						const int Error = errno;
+						close(FileDescriptor);
+						throw std::system_error(Error, std::generic_category(), "InputManager: cannot map " + Path);
+					}
+					madvise(Map, Size__, MADV_SEQUENTIAL);
+					Data__ = static_cast<const char*>(Map);
+				}
+				close(FileDescriptor);
+#else
+				std::ifstream File(Path, std::ios::binary);
+				if (!File) {
+					throw std::system_error(errno, std::generic_category(), "InputManager: cannot open " + Path);
+				}
+				Copy__.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+				Data__ = Copy__.data();
+				Size__ = Copy__.size();
+#endif
+			}
+			~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+				if (Data__) {
+					munmap(const_cast<char*>(Data__), Size__);
+				}
+#endif
+			}
+			std::string_view Text() const {
+				return std::string_view(Data__, Size__);
+			}
+	};
+}
+
+/**
+ * @brief This class reads back tables printed by OutputManager.
+ *
+ * @details Parses text printed with FormatToColumns(It, It, Its...) or operator()(T&&, P&&...), one element per column and one row per line, into a `std::vector` per column. The separator and end of line must be the ones used to print. Numbers are read with `std::from_chars`, files are memory mapped and fields are delimited with SIMD scanning, chosen at run time by OutputManagerDetail::Cpu().
+ * @details Spaces around fields are padding and are dropped, and so is the padding internal alignment puts between a minus sign and the digits. If the separator is made only of spaces or tabs, any run of them separates two fields, as `operator>>` would. A field starting with the quote character, `"` by default, extends to the matching quote, may hold separators and ends of line, and a doubled quote inside it stands for one quote. Blank lines are skipped.
+ *
+ * **Example:**
+ * ```.cpp
+ * #include <fstream>
+ * #include <vector>
+ * #include <string>
+ * #include "InputManager.h"
+ *
+ * int main () {
+ *     std::vector<int> Numbers {1, 2, 3};
+ *     std::vector<double> Floats {1.1, 2.1, 3.1};
+ *     std::vector<std::wstring> Words {L"Cat", L"Dog", L"Mouse"};
+ *     {
+ *         std::wofstream File("Table.txt");
+ *         OutputManager O(File);
+ *         O.SetWidth(8);
+ *         O.FormatToColumns(Numbers.begin(), Numbers.end(), Floats.begin(), Words.begin());
+ *     }
+ *     std::vector<int> NewNumbers;
+ *     std::vector<double> NewFloats;
+ *     std::vector<std::wstring> NewWords;
+ *     InputManager I;
+ *     I.ReadColumns("Table.txt", NewNumbers, NewFloats, NewWords);
+ * }
+ * ```
+ * @tparam StringType The type of the separator and end of line strings, as in OutputManager. Their characters must be ASCII.
+ * @warning Numbers printed with per-column formats, in a base other than 10, or with stream flags `std::from_chars` does not read, such as `std::showpos`, cannot be read back.
+ */
+template<typename StringType = std::wstring> class InputManager {
+	protected:
+		/**
+		 * @brief The separator between fields, narrowed. Default is `" "`.
+		 * @see SetSeparator(StringType&&)
+		 */
+		std::string Separator__;
+		/**
+		 * @brief The end of line, narrowed. Default is `"\n"`.
+		 * @see SetEndOfLine(StringType&&)
+		 */
+		std::string EndOfLine__;
+		/**
+		 * @brief The character quoting fields, `'\0'` if fields are never quoted. Default is `'"'`.
+		 * @see SetQuote(char)
+		 */
+		char Quote__ = '"';
+		/**
+		 * @brief `true` if `Separator__` is made only of spaces and tabs, in which case any run of them separates fields.
+		 */
+		bool Blank__ = true;
+		/**
+		 * @brief The number of threads used by the parallel readers. Default is `0`, which stands for `std::thread::hardware_concurrency()`.
+		 * @see SetWorkers(size_t)
+		 */
+		size_t Workers__ = 0;
+		/**
+		 * @brief The locale whose `codecvt` decodes wide strings and characters. Default is the global locale, the one a file stream is imbued with when it is opened.
+		 * @see SetLocale(std::locale const&)
+		 */
+		std::locale Locale__;
+		/**
+		 * @brief The `codecvt` facet of `Locale__`, looked up once.
+		 */
+		const std::codecvt<wchar_t, char, std::mbstate_t>* Decode__ = &std::use_facet<std::codecvt<wchar_t, char, std::mbstate_t>>(Locale__);
+		/**
+		 * @brief The smallest number of bytes the parallel readers give to a chunk.
+		 */
+		static constexpr size_t MinChunk__ = 1 << 20;
+
+		/**
+		 * @brief Narrows a separator or end of line string.
+		 */
+		static std::string Narrow__(StringType const& Text);
+		/**
+		 * @brief Tells if `Character` is padding around fields.
+		 */
+		bool IsPadding__(char Character) const;
+		/**
+		 * @brief Reads the next field of a line.
+		 *
+		 * @details Skips the padding before the field, then finds its end. Quoted fields are unquoted into `Unquoted`, which the returned view then refers to.
+		 * @param Cursor The start of the field, moved past the separator or end of line that ends it.
+		 * @param End The end of the text.
+		 * @param Unquoted Storage for the content of quoted fields.
+		 * @param Last Set to `true` if the field is the last of its line.
+		 * @return The field, without padding.
+		 * @throw std::runtime_error If a quoted field is not closed.
+		 */
+		std::string_view Field__(const char*& Cursor, const char* End, std::string& Unquoted, bool& Last) const;
+		/**
+		 * @brief Reads a single field into a value.
+		 * @details Wide strings and characters are decoded with the `codecvt` of `Locale__`, undoing what a wide file stream imbued with it wrote.
+		 * @return `false` if the field is malformed.
+		 */
+		template<typename T> bool Parse__(std::string_view Field, T& Value) const;
+		/**
+		 * @brief Parses all lines between `Begin` and `End` and appends their fields to the columns.
+		 * @details If a line fails, the part of it already appended is removed, so the columns always hold whole rows. Padding between a minus sign and the digits, printed with internal alignment, is skipped.
+		 * @param Line The number of the first line, used in error messages.
+		 * @return The number of rows read.
+		 * @throw std::runtime_error If a line has the wrong number of fields or a field is malformed. The rows before it are kept.
+		 */
+		template<typename... T> size_t ParseRange__(const char* Begin, const char* End, size_t Line, std::vector<T>&... Columns) const;
+		/**
+		 * @brief The number of ends of line between `Begin` and `End`, quoted or not.
+		 */
+		size_t CountLines__(const char* Begin, const char* End) const;
+		/**
+		 * @brief Splits a text into chunks of whole lines, none starting inside a quoted field.
+		 *
+		 * @details Works in two passes. The first one, in parallel, scans every slice of the text for its quotes and for the first end of line that follows an even number of them and the first that follows an odd number, speculating on either state at the start of the slice. The quote counts then tell the actual state at each slice start, which picks one of the two candidates without scanning again.
+		 * @warning Quote characters are expected only around and doubled inside quoted fields, as in CSV.
+		 * @return The start of every chunk, followed by `End`.
+		 */
+		std::vector<const char*> Split__(const char* Begin, const char* End, size_t Workers) const;
+
+	public:
+		/**
+		 * @brief Construct a new Input Manager object, reading fields separated by a space and lines ended by `'\n'`, as OutputManager prints them by default.
+		 */
+		InputManager();
+		/**
+		 * @brief Construct a new Input Manager object with the given separator and end of line.
+		 */
+		InputManager(StringType&& Separator, StringType&& EndOfLine);
+
+		/**
+		 * @brief Parses a table held in memory, appending one element to each column for every line.
+		 * @tparam T The types of the columns: numbers, `bool`, `char`, strings of `char` or `wchar_t`, or types with an InputParser specialisation.
+		 * @return The number of rows read.
+		 * @throw std::runtime_error If a line has the wrong number of fields or a field is malformed.
+		 */
+		template<typename... T> size_t ParseColumns(std::string_view Text, std::vector<T>&... Columns) const;
+		/**
+		 * @brief Reads a table from a file, appending one element to each column for every line.
+		 * @see ParseColumns(std::string_view, std::vector<T>&...)
+		 * @return The number of rows read.
+		 * @throw std::system_error If the file cannot be read.
+		 * @throw std::runtime_error If a line has the wrong number of fields or a field is malformed.
+		 */
+		template<typename... T> size_t ReadColumns(std::string const& Path, std::vector<T>&... Columns) const;
+		/**
+		 * @brief Parses a table held in memory on several threads, with the same result as ParseColumns(std::string_view, std::vector<T>&...).
+		 *
+		 * @details The text is split at line boundaries into chunks, see Split__(const char*, const char*, size_t). Every chunk is parsed on a work-stealing pool into its own columns, which are then moved in order at the end of `Columns`, also in parallel.
+		 * @warning Every type in `T` must be default constructible and movable, and quote characters must only appear as in CSV.
+		 * @return The number of rows read.
+		 * @throw std::runtime_error If a line has the wrong number of fields or a field is malformed, reporting the same line as ParseColumns(std::string_view, std::vector<T>&...). The rows before it are kept, as they are by ParseColumns(std::string_view, std::vector<T>&...).
+		 */
+		template<typename... T> size_t ParallelParseColumns(std::string_view Text, std::vector<T>&... Columns) const;
+		/**
+		 * @brief Reads a table from a file on several threads.
+		 * @see ParallelParseColumns(std::string_view, std::vector<T>&...)
+		 * @return The number of rows read.
+		 * @throw std::system_error If the file cannot be read.
+		 * @throw std::runtime_error If a line has the wrong number of fields or a field is malformed.
+		 */
+		template<typename... T> size_t ParallelReadColumns(std::string const& Path, std::vector<T>&... Columns) const;
+
+		/**
+		 * @brief Sets the separator between fields, which should be the one used to print.
+		 */
+		void SetSeparator(StringType&& Separator);
+		/**
+		 * @brief Sets the end of line, which should be the one used to print.
+		 */
+		void SetEndOfLine(StringType&& EndOfLine);
+		/**
+		 * @brief Sets the character quoting fields.
+		 * @param Quote The quote character, `'\0'` to read quotes as plain characters.
+		 */
+		void SetQuote(char Quote);
+		/**
+		 * @brief Sets the number of threads used by the parallel readers.
+		 * @param Workers The number of threads, if `0` it defaults to `std::thread::hardware_concurrency()`.
+		 */
+		void SetWorkers(size_t Workers);
+		/**
+		 * @brief Sets the locale wide strings and characters are decoded with, which should be the one the printing stream was imbued with.
+		 */
+		void SetLocale(std::locale const& Locale);
+};
+
+//
+//CONSTRUCTORS
+//
+template<typename StringType>
+InputManager<StringType> ::InputManager() : InputManager(OutputManagerDetail::DefaultText<StringType>(" "), OutputManagerDetail::DefaultText<StringType>("\n")) {
+}
+
+template<typename StringType>
+InputManager<StringType> ::InputManager(StringType&& Separator, StringType&& EndOfLine) {
+	SetSeparator(std::move(Separator));
+	SetEndOfLine(std::move(EndOfLine));
+}
+
+//
+//READERS
+//
+template<typename StringType>
+template<typename... T>
+size_t InputManager<StringType> ::ParseColumns(std::string_view Text, std::vector<T>&... Columns) const {
+	return ParseRange__(Text.data(), Text.data() + Text.size(), 1, Columns...);
+}
+
+template<typename StringType>
+template<typename... T>
+size_t InputManager<StringType> ::ReadColumns(std::string const& Path, std::vector<T>&... Columns) const {
+	const InputManagerDetail::MappedFile File(Path);
+	return ParseColumns(File.Text(), Columns...);
+}
+
+template<typename StringType>
+template<typename... T>
+size_t InputManager<StringType> ::ParallelParseColumns(std::string_view Text, std::vector<T>&... Columns) const {
+	const size_t Workers = Workers__ ? Workers__ : std::max(1u, std::thread::hardware_concurrency());
+	const char* Begin = Text.data();
+	const std::vector<const char*> Bounds = Split__(Begin, Begin + Text.size(), Workers);
+	const size_t Chunks = Bounds.size() - 1;
+	if (Chunks <= 1) {
+		return ParseColumns(Text, Columns...);
+	}
+	std::vector<std::tuple<std::vector<T>...>> Parts(Chunks);
+	std::vector<size_t> Rows(Chunks, 0);
+	std::vector<char> Done(Chunks, 0);
+	std::vector<std::function<void()>> Tasks;
+	for (size_t i = 0; i < Chunks; ++i) {
+		Tasks.emplace_back([&, i]() {
+			std::apply([&](auto&... Part) {
+				Rows[i] = ParseRange__(Bounds[i], Bounds[i + 1], 1, Part...);
+			}, Parts[i]);
+			Done[i] = 1;
+		});
+	}
+	try {
+		OutputManagerDetail::RunWorkStealing(Tasks, Workers);
+	}
+	catch (std::runtime_error const&) {
+		//Lines are only counted on failure: the first chunk that fails is parsed again knowing where it starts, which throws the exact error.
+		size_t Line = 1;
+		for (size_t i = 0; i < Chunks; Line += CountLines__(Bounds[i], Bounds[i + 1]), ++i) {
+			if (Done[i]) {
+				continue;
+			}
+			try {
+				std::apply([&](auto&... Part) {
+					((Part.clear()),...);
+					ParseRange__(Bounds[i], Bounds[i + 1], Line, Part...);
+				}, Parts[i]);
+			}
+			catch (std::runtime_error const&) {
+				//Like ParseColumns(std::string_view, std::vector<T>&...), keeps every whole row before the error.
+				for (size_t j = 0; j <= i; ++j) {
+					std::apply([&](auto&... Part) {
+						(Columns.insert(Columns.end(), std::make_move_iterator(Part.begin()), std::make_move_iterator(Part.end())),...);
+					}, Parts[j]);
+				}
+				throw;
+			}
+		}
+		throw;
+	}
+	std::vector<size_t> Offsets(Chunks + 1, 0);
+	for (size_t i = 0; i < Chunks; ++i) {
+		Offsets[i + 1] = Offsets[i] + Rows[i];
+	}
+	//Columns may already hold different numbers of elements, so each grows from its own end.
+	(Columns.resize(Columns.size() + Offsets[Chunks]),...);
+	Tasks.clear();
+	for (size_t i = 0; i < Chunks; ++i) {
+		Tasks.emplace_back([&, i]() {
+			std::apply([&](auto&... Part) {
+				(std::move(Part.begin(), Part.end(), Columns.end() - Offsets[Chunks] + Offsets[i]),...);
+				((Part = {}),...);
+			}, Parts[i]);
+		});
+	}
+	OutputManagerDetail::RunWorkStealing(Tasks, Workers);
+	return Offsets[Chunks];
+}
+
+template<typename StringType>
+template<typename... T>
+size_t InputManager<StringType> ::ParallelReadColumns(std::string const& Path, std::vector<T>&... Columns) const {
+	const InputManagerDetail::MappedFile File(Path);
+	return ParallelParseColumns(File.Text(), Columns...);
+}
+
+//
+//HELPERS
+//
+template<typename StringType>
+std::string InputManager<StringType> ::Narrow__(StringType const& Text) {
+	std::string Narrow(Text.size(), '\0');
+	for (size_t i = 0; i < Text.size(); ++i) {
+		Narrow[i] = static_cast<char>(Text[i]);
+	}
+	return Narrow;
+}
+
+template<typename StringType>
+bool InputManager<StringType> ::IsPadding__(char Character) const {
+	return Character == ' ' || (Blank__ && Character == '\t');
+}
+
+template<typename StringType>
+std::string_view InputManager<StringType> ::Field__(const char*& Cursor, const char* End, std::string& Unquoted, bool& Last) const {
+	const char* Begin = Cursor;
+	while (Begin != End && IsPadding__(*Begin)) {
+		++Begin;
+	}
+	std::string_view Field;
+	const char* Stop = Begin;
+	if (Quote__ && Begin != End && *Begin == Quote__) {
+		Unquoted.clear();
+		for (const char* Rest = Begin + 1;;) {
+			const char* Close = static_cast<const char*>(std::memchr(Rest, Quote__, End - Rest));
+			if (!Close) {
+				throw std::runtime_error("InputManager: unterminated quoted field");
+			}
+			Unquoted.append(Rest, Close);
+			if (Close + 1 != End && Close[1] == Quote__) {
+				Unquoted += Quote__;
+				Rest = Close + 2;
+				continue;
+			}
+			Stop = Close + 1;
+			break;
+		}
+		Field = Unquoted;
+		while (Stop != End && IsPadding__(*Stop)) {
+			++Stop;
+		}
+	}
+	else {
+		//With blank separators a field ends at the first space, otherwise only at a full separator.
+		const char First = Blank__ ? ' ' : Separator__[0];
+		const char Second = Blank__ ? '\t' : First;
+		for (Stop = Begin;; ++Stop) {
+			Stop = InputManagerDetail::FindAny(Stop, End, First, Second, EndOfLine__[0]);
+			if (Stop == End || Blank__ || std::string_view(Stop, End - Stop).substr(0, Separator__.size()) == Separator__ || std::string_view(Stop, End - Stop).substr(0, EndOfLine__.size()) == EndOfLine__) {
+				break;
+			}
+		}
+		const char* FieldEnd = Stop;
+		while (FieldEnd != Begin && IsPadding__(FieldEnd[-1])) {
+			--FieldEnd;
+		}
+		Field = std::string_view(Begin, FieldEnd - Begin);
+		while (Stop != End && IsPadding__(*Stop)) {
+			++Stop;
+		}
+	}
+	const std::string_view Rest(Stop, End - Stop);
+	if (Rest.empty()) {
+		Last = true;
+		Cursor = End;
+	}
+	else if (Rest.substr(0, EndOfLine__.size()) == EndOfLine__) {
+		Last = true;
+		Cursor = Stop + EndOfLine__.size();
+	}
+	else if (!Blank__ && Rest.substr(0, Separator__.size()) == Separator__) {
+		Last = false;
+		Cursor = Stop + Separator__.size();
+	}
+	else if (Blank__) {
+		Last = false;
+		Cursor = Stop;
+	}
+	else {
+		throw std::runtime_error("InputManager: unexpected characters after a quoted field");
+	}
+	return Field;
+}
+
+template<typename StringType>
+template<typename T>
+bool InputManager<StringType> ::Parse__(std::string_view Field, T& Value) const {
+	const char* Begin = Field.data();
+	const char* End = Begin + Field.size();
+	if constexpr (InputManagerDetail::HasInputParser<T>::value) {
+		return InputParser<T>::parse(Begin, End, Value);
+	}
+	else if constexpr (OutputManagerDetail::IsNumericInteger<T> || std::is_floating_point_v<T>) {
+		const auto Result = std::from_chars(Begin, End, Value);
+		return Result.ec == std::errc() && Result.ptr == End;
+	}
+	else if constexpr (std::is_same_v<T, bool>) {
+		//Printed as `0` or `1`, like operator<< without std::boolalpha.
+		if (Field.size() != 1 || (Field[0] != '0' && Field[0] != '1')) {
+			return false;
+		}
+		Value = Field[0] == '1';
+		return true;
+	}
+	else if constexpr (std::is_same_v<T, char>) {
+		if (Field.size() != 1) {
+			return false;
+		}
+		Value = Field[0];
+		return true;
+	}
+	else if constexpr (std::is_same_v<T, wchar_t>) {
+		std::wstring Wide;
+		if (!Parse__(Field, Wide) || Wide.size() != 1) {
+			return false;
+		}
+		Value = Wide[0];
+		return true;
+	}
+	else if constexpr (std::is_same_v<T, std::string>) {
+		Value.assign(Begin, End);
+		return true;
+	}
+	else if constexpr (std::is_same_v<T, std::wstring>) {
+		//No encoding takes fewer bytes than wide characters.
+		Value.resize(Field.size());
+		std::mbstate_t State{};
+		const char* Read = Begin;
+		wchar_t* Written = Value.data();
+		const auto Result = Decode__->in(State, Begin, End, Read, Value.data(), Value.data() + Value.size(), Written);
+		if (Result == std::codecvt_base::noconv) {
+			std::transform(Begin, End, Value.begin(), [](char Byte) {
+				return wchar_t(static_cast<unsigned char>(Byte));
+			});
+			return true;
+		}
+		if (Result != std::codecvt_base::ok || Read != End) {
+			return false;
+		}
+		Value.resize(Written - Value.data());
+		return true;
+	}
+	else {
+		static_assert(InputManagerDetail::HasInputParser<T>::value, "InputManager: no way to read this type, specialise InputParser");
+		return false;
+	}
+}
+
+template<typename StringType>
+template<typename... T>
+size_t InputManager<StringType> ::ParseRange__(const char* Begin, const char* End, size_t Line, std::vector<T>&... Columns) const {
+	static_assert(sizeof...(T) > 0, "InputManager: at least one column is needed");
+	std::string Unquoted, Signed;
+	size_t Rows = 0;
+	const size_t Sizes[] = {Columns.size()...};
+	auto Fail = [&](const char* What) {
+		throw std::runtime_error("InputManager: line " + std::to_string(Line) + ": " + What);
+	};
+	while (Begin != End) {
+		//Blank lines are skipped.
+		const char* Start = Begin;
+		while (Start != End && IsPadding__(*Start)) {
+			++Start;
+		}
+		if (Start == End) {
+			break;
+		}
+		if (std::string_view(Start, End - Start).substr(0, EndOfLine__.size()) == EndOfLine__) {
+			Begin = Start + EndOfLine__.size();
+			++Line;
+			continue;
+		}
+		bool Last = false;
+		size_t Index = 0;
+		size_t Quoted = 0;
+		try {
+			([&](auto& Column) {
+				auto& Target = Column.emplace_back();
+				if (Last) {
+					Fail("too few fields");
+				}
+				std::string_view Field = Field__(Begin, End, Unquoted, Last);
+				if (Field.data() == Unquoted.data()) {
+					//Lines inside quoted fields still count, so that line numbers are those of the file.
+					Quoted += CountLines__(Field.data(), Field.data() + Field.size());
+				}
+				else if constexpr (OutputManagerDetail::IsNumericInteger<std::decay_t<decltype(Target)>> || std::is_floating_point_v<std::decay_t<decltype(Target)>>) {
+					//Internal alignment pads between the sign and the digits, which blank separators even split into two fields.
+					if (Field == "-" && !Last && Blank__) {
+						Signed.assign(1, '-');
+						Signed.append(Field__(Begin, End, Unquoted, Last));
+						Field = Signed;
+					}
+					else if (Field.size() > 1 && Field[0] == '-' && IsPadding__(Field[1])) {
+						size_t Digits = 1;
+						while (Digits != Field.size() && IsPadding__(Field[Digits])) {
+							++Digits;
+						}
+						Signed.assign(1, '-');
+						Signed.append(Field.substr(Digits));
+						Field = Signed;
+					}
+				}
+				if (!Parse__(Field, Target)) {
+					Fail(("malformed field " + std::to_string(Index)).c_str());
+				}
+				++Index;
+			}(Columns),...);
+			if (!Last) {
+				//Tolerates the trailing separator printed by FormatToRows(It, It, Its...).
+				const std::string_view Rest = Field__(Begin, End, Unquoted, Last);
+				if (!Rest.empty() || !Last) {
+					Fail("too many fields");
+				}
+			}
+		}
+		catch (...) {
+			//Drops the part of the line already read, so that every column keeps whole rows.
+			size_t Column = 0;
+			(Columns.resize(Sizes[Column++] + Rows),...);
+			throw;
+		}
+		++Rows;
+		Line += 1 + Quoted;
+	}
+	return Rows;
+}
+
+template<typename StringType>
+size_t InputManager<StringType> ::CountLines__(const char* Begin, const char* End) const {
+	const std::string_view Text(Begin, End - Begin);
+	size_t Lines = 0;
+	for (size_t Position = Text.find(EndOfLine__); Position != std::string_view::npos; Position = Text.find(EndOfLine__, Position + EndOfLine__.size())) {
+		++Lines;
+	}
+	return Lines;
+}
+
+template<typename StringType>
+std::vector<const char*> InputManager<StringType> ::Split__(const char* Begin, const char* End, size_t Workers) const {
+	const size_t Size = End - Begin;
+	const size_t Slices = std::max<size_t>(1, std::min(4 * Workers, Size / MinChunk__));
+	struct Slice {
+		const char* Begin;
+		size_t Quotes = 0;
+		//The first line start after the slice start, if it started outside or inside a quoted field.
+		const char* Outside = nullptr;
+		const char* Inside = nullptr;
+	};
+	std::vector<Slice> Scans(Slices);
+	std::vector<std::function<void()>> Tasks;
+	for (size_t i = 0; i < Slices; ++i) {
+		Scans[i].Begin = Begin + Size * i / Slices;
+		Tasks.emplace_back([&, i]() {
+			Slice& Scan = Scans[i];
+			const char* SliceEnd = Begin + Size * (i + 1) / Slices;
+			const char Quote = Quote__ ? Quote__ : EndOfLine__[0];
+			for (const char* Cursor = Scan.Begin;;) {
+				Cursor = InputManagerDetail::FindAny(Cursor, SliceEnd, Quote, EndOfLine__[0], EndOfLine__[0]);
+				if (Cursor == SliceEnd) {
+					break;
+				}
+				if (Quote__ && *Cursor == Quote__) {
+					++Scan.Quotes;
+					++Cursor;
+					continue;
+				}
+				if (std::string_view(Cursor, End - Cursor).substr(0, EndOfLine__.size()) == EndOfLine__) {
+					const char*& Candidate = Scan.Quotes % 2 ? Scan.Inside : Scan.Outside;
+					if (!Candidate) {
+						Candidate = Cursor + EndOfLine__.size();
+					}
+				}
+				++Cursor;
+			}
+		});
+	}
+	OutputManagerDetail::RunWorkStealing(Tasks, Workers);
+	std::vector<const char*> Bounds {Begin};
+	bool Quoted = false;
+	for (size_t i = 1; i < Slices; ++i) {
+		Quoted = Quoted != (Scans[i - 1].Quotes % 2 == 1);
+		//The state at the start of a slice picks its candidate, a slice without one is joined to the previous chunk.
+		const char* Start = Quoted ? Scans[i].Inside : Scans[i].Outside;
+		if (Start && Start > Bounds.back() && Start < End) {
+			Bounds.push_back(Start);
+		}
+	}
+	Bounds.push_back(End);
+	return Bounds;
+}
+
+//
+//SETTERS
+//
+template<typename StringType>
+void InputManager<StringType> ::SetSeparator(StringType&& Separator) {
+	Separator__ = Narrow__(Separator);
+	Blank__ = Separator__.find_first_not_of(" \t") == std::string::npos;
+	if (Separator__.empty()) {
+		Separator__ = " ";
+	}
+}
+
+template<typename StringType>
+void InputManager<StringType> ::SetEndOfLine(StringType&& EndOfLine) {
+	EndOfLine__ = Narrow__(EndOfLine);
+	if (EndOfLine__.empty()) {
+		EndOfLine__ = "\n";
+	}
+}
+
+template<typename StringType>
+void InputManager<StringType> ::SetQuote(char Quote) {
+	Quote__ = Quote;
+}
+
+template<typename StringType>
+void InputManager<StringType> ::SetWorkers(size_t Workers) {
+	Workers__ = Workers;
+}
+
+template<typename StringType>
+void InputManager<StringType> ::SetLocale(std::locale const& Locale) {
+	Locale__ = Locale;
+	Decode__ = &std::use_facet<std::codecvt<wchar_t, char, std::mbstate_t>>(Locale__);
+}
+
+#endif
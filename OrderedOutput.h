@@ -0,0 +1,378 @@
+#ifndef ORDEREDOUTPUT_H
+#define ORDEREDOUTPUT_H
+
+/**
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include <string>
+#include <vector>
+#include <sstream>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <cstdio>
+
+/**
+ * @brief Collects the lines printed by the iterations of a parallel loop and writes them in iteration order.
+ *
+ * @details Every iteration owns a slot. operator()(size_t, T const&...) formats a line into the slot of an iteration, so any number of threads can print at once without interleaving. Once an iteration calls Done(size_t), its slot and all the following finished ones are written to the stream of the OutputManager as soon as all the earlier slots are, so output flows while the loop runs. Finish(), also called by the destructor, writes whatever is left; only an explicit call reports a spill file that cannot be read back. The output is the same whatever the number of threads and the schedule.
+ * @details Lines are formatted by a few OutputManager objects, one for each thread printing at the same time, which are kept and reused for the whole loop. The slots waiting for an earlier iteration are bounded by the memory cap of the OutputManager, see OutputManager::SetMemoryCap(size_t, int): beyond it, a thread printing any iteration but the first unwritten one waits, or, if the cap spills, finished slots go to a temporary file until their turn.
+ *
+ * **Example:**
+ * ```.cpp
+ * #include <cmath>
+ * #include "OrderedOutput.h"
+ * #include "OutputManagerConsole.h"
+ *
+ * int main () {
+ *     OutputManager O;
+ *     OrderedOutput Lines(O, 1000);
+ *     #pragma omp parallel for
+ *     for (int i = 0; i < 1000; ++i) {
+ *         Lines(i, i, std::sqrt(i));
+ *         Lines.Done(i);
+ *     }
+ *     Lines.Finish();
+ * }
+ * ```
+ * @tparam OutType The type of the output stream of the OutputManager.
+ * @tparam StringType The type of the separator and and of line strings of the OutputManager.
+ * @warning Lines are formatted with the settings the OutputManager had when the OrderedOutput was created. The OutputManager must not print anything else until Finish() returns.
+ * @warning With a memory cap that waits, every thread must print its iterations in increasing order and call Done(size_t) for each, as the usual OpenMP schedules do, or a thread may wait forever for an iteration nobody prints.
+ */
+template<typename OutType = std::wostream, typename StringType = std::wstring> class OrderedOutput {
+	protected:
+		using Char__ = typename OutType::char_type;
+		using Stream__ = std::basic_ostream<Char__, typename OutType::traits_type>;
+		using Buffer__ = std::basic_ostringstream<Char__, typename OutType::traits_type>;
+		using Text__ = OutputManagerDetail::OutputBuffer<Char__>;
+		/**
+		 * @brief A stream buffer appending everything written to it to a Text__, so that the lines printed with `operator<<` land in a slot too.
+		 */
+		class Sink__ : public std::basic_streambuf<Char__, typename OutType::traits_type> {
+			private:
+				using Traits__ = typename OutType::traits_type;
+
+			protected:
+				typename Traits__::int_type overflow(typename Traits__::int_type Character) override {
+					if (!Traits__::eq_int_type(Character, Traits__::eof())) {
+						const Char__ Value = Traits__::to_char_type(Character);
+						Target->Append(&Value, 1);
+					}
+					return Traits__::not_eof(Character);
+				}
+				std::streamsize xsputn(const Char__* Text, std::streamsize Count) override {
+					Target->Append(Text, size_t(Count));
+					return Count;
+				}
+
+			public:
+				/**
+				 * @brief Where the characters go.
+				 */
+				Text__* Target = nullptr;
+		};
+		/**
+		 * @brief An OutputManager writing through a Sink__, used by one thread at a time.
+		 */
+		struct Formatter__ {
+			Sink__ Sink;
+			Stream__ Stream{&Sink};
+			OutputManager<Stream__, StringType> Manager{Stream};
+		};
+		/**
+		 * @brief The output of a single iteration.
+		 */
+		struct Slot__ {
+			/**
+			 * @brief The formatted lines, ends of line included.
+			 */
+			Text__ Text;
+			/**
+			 * @brief Where the lines went in the spill file, `-1` if they are in `Text`, and how many characters they are.
+			 */
+			long Offset = -1;
+			size_t Length = 0;
+			/**
+			 * @brief `true` once the iteration called Done(size_t).
+			 */
+			bool Done = false;
+		};
+
+		/**
+		 * @brief The OutputManager whose stream is written to.
+		 */
+		OutputManager<OutType, StringType>& Manager__;
+		/**
+		 * @brief One slot per iteration.
+		 */
+		std::vector<Slot__> Slots__;
+		/**
+		 * @brief The first slot not written yet.
+		 */
+		size_t Next__ = 0;
+		/**
+		 * @brief Guards `Next__`, the `Done` flags, the spill file and the stream of `Manager__`.
+		 */
+		std::mutex Lock__;
+		/**
+		 * @brief Wakes the threads waiting for the slots to drain.
+		 */
+		std::condition_variable Room__;
+		/**
+		 * @brief The memory cap and the bytes held by the slots, those of `Manager__`, or `nullptr` if it has none.
+		 */
+		OutputManagerDetail::Limits* Limits__;
+		/**
+		 * @brief The temporary file finished slots are spilled to, opened on first use.
+		 */
+		std::unique_ptr<std::FILE, int(*)(std::FILE*)> SpillFile__{nullptr, &std::fclose};
+		/**
+		 * @brief The block spilled slots are read back through.
+		 */
+		std::unique_ptr<Char__[]> ReadBack__;
+		/**
+		 * @brief The stream `Prototype__` writes to, never used.
+		 */
+		Buffer__ Settings__;
+		/**
+		 * @brief An OutputManager with the settings of `Manager__`, copied by every formatter so that none of them reads the stream being written.
+		 */
+		OutputManager<Stream__, StringType> Prototype__;
+		/**
+		 * @brief The formatters not in use, and their lock.
+		 */
+		std::vector<std::unique_ptr<Formatter__>> Idle__;
+		std::mutex IdleLock__;
+
+		/**
+		 * @brief Takes an idle formatter, or makes one with the settings of `Prototype__`.
+		 */
+		std::unique_ptr<Formatter__> Acquire__();
+		/**
+		 * @brief Gives a formatter back for other lines.
+		 */
+		void Release__(std::unique_ptr<Formatter__> Formatter);
+		/**
+		 * @brief `true` if the slots hold more than the memory cap.
+		 */
+		bool Full__() const;
+		/**
+		 * @brief Moves the lines of a finished slot to the spill file, leaving them in memory if it cannot be written.
+		 * @warning `Lock__` must be held.
+		 */
+		void Spill__(Slot__& Slot);
+		/**
+		 * @brief Writes every finished slot from `Next__` on, stopping at the first unfinished one unless `All` is `true`.
+		 * @warning `Lock__` must be held.
+		 * @throw std::runtime_error If a spilled slot cannot be read back.
+		 */
+		void Emit__(bool All);
+
+	public:
+		OrderedOutput(OrderedOutput const&) = delete;
+		OrderedOutput& operator=(OrderedOutput const&) = delete;
+
+		/**
+		 * @brief Creates the slots for a loop.
+		 * @param Manager The OutputManager whose settings are used to format lines and whose stream is written to.
+		 * @param Iterations The number of iterations of the loop.
+		 */
+		OrderedOutput(OutputManager<OutType, StringType>& Manager, size_t Iterations);
+		/**
+		 * @brief Writes the slots left like Finish(), but drops any exception.
+		 * @details Call Finish() first to learn whether a spilled slot could not be read back.
+		 */
+		~OrderedOutput();
+
+		/**
+		 * @brief Formats a line into the slot of an iteration.
+		 *
+		 * @details The line is formatted as operator()(T&&, P&&...) would print it, and follows any line already in the slot. Different iterations can call it concurrently.
+		 * @warning The same iteration must not be printed to from two threads at once, nor after Done(size_t).
+		 * @param Iteration The iteration, smaller than the number of iterations.
+		 */
+		template<typename... T> void operator()(size_t Iteration, T const&... Elements);
+		/**
+		 * @brief Marks an iteration as finished, writing its slot as soon as all the earlier ones are written.
+		 * @param Iteration The iteration, smaller than the number of iterations.
+		 */
+		void Done(size_t Iteration);
+		/**
+		 * @brief Writes all slots not written yet in order, finished or not.
+		 * @warning Must be called after the loop, not concurrently with it.
+		 * @throw std::runtime_error If a spilled slot cannot be read back. The slots before it are written, it and the following ones are not.
+		 */
+		void Finish();
+		/**
+		 * @brief The number of iterations.
+		 */
+		size_t Size() const;
+};
+
+//
+//CONSTRUCTORS
+//
+template<typename OutType, typename StringType>
+OrderedOutput<OutType, StringType> ::OrderedOutput(OutputManager<OutType, StringType>& Manager, size_t Iterations) : Manager__{Manager}, Slots__(Iterations), Limits__{Manager.Limits__()}, Prototype__{Settings__} {
+	Manager__.CopySettingsTo__(Prototype__);
+}
+
+template<typename OutType, typename StringType>
+OrderedOutput<OutType, StringType> ::~OrderedOutput() {
+	//A destructor must not throw, so a failure is only reported by an explicit Finish().
+	try {
+		Finish();
+	}
+	catch (...) {
+	}
+}
+
+//
+//SLOTS
+//
+template<typename OutType, typename StringType>
+template<typename... T>
+void OrderedOutput<OutType, StringType> ::operator()(size_t Iteration, T const&... Elements) {
+	Slot__& Slot = Slots__[Iteration];
+	if (Limits__ && Limits__->MemoryCap && Limits__->Overflow <= 0) {
+		//The first unwritten iteration always goes on, so the others can wait for it.
+		std::unique_lock<std::mutex> Guard(Lock__);
+		Room__.wait(Guard, [&]() {
+			return Iteration == Next__ || !Full__();
+		});
+	}
+	std::unique_ptr<Formatter__> Formatter = Acquire__();
+	const size_t Before = Slot.Text.Size();
+	try {
+		//A manipulator printed by an earlier line must not leak into this one.
+		Formatter->Stream.flags(Settings__.flags());
+		Formatter->Stream.precision(Settings__.precision());
+		Formatter->Stream.fill(Settings__.fill());
+		Formatter->Sink.Target = &Slot.Text;
+		Formatter->Manager.Refresh__();
+		Formatter->Manager.AppendLine__(Elements...);
+		Formatter->Manager.Flush__();
+	}
+	catch (...) {
+		Formatter->Manager.Buffer__.Clear();
+		Slot.Text.Truncate(Before);
+		Release__(std::move(Formatter));
+		throw;
+	}
+	Release__(std::move(Formatter));
+	if (Limits__) {
+		const size_t Bytes = (Slot.Text.Size() - Before) * sizeof(Char__);
+		Manager__.Track__(Manager__.Buffer__.Capacity() * sizeof(Char__) + (Limits__->Pending += Bytes));
+	}
+}
+
+template<typename OutType, typename StringType>
+void OrderedOutput<OutType, StringType> ::Done(size_t Iteration) {
+	std::lock_guard<std::mutex> Guard(Lock__);
+	Slots__[Iteration].Done = true;
+	if (Iteration == Next__) {
+		Emit__(false);
+	}
+	else if (Limits__ && Limits__->Overflow > 0 && Full__()) {
+		Spill__(Slots__[Iteration]);
+	}
+}
+
+template<typename OutType, typename StringType>
+void OrderedOutput<OutType, StringType> ::Finish() {
+	std::lock_guard<std::mutex> Guard(Lock__);
+	Emit__(true);
+}
+
+template<typename OutType, typename StringType>
+size_t OrderedOutput<OutType, StringType> ::Size() const {
+	return Slots__.size();
+}
+
+//
+//HELPERS
+//
+template<typename OutType, typename StringType>
+std::unique_ptr<typename OrderedOutput<OutType, StringType>::Formatter__> OrderedOutput<OutType, StringType> ::Acquire__() {
+	{
+		std::lock_guard<std::mutex> Guard(IdleLock__);
+		if (!Idle__.empty()) {
+			std::unique_ptr<Formatter__> Formatter = std::move(Idle__.back());
+			Idle__.pop_back();
+			return Formatter;
+		}
+	}
+	auto Formatter = std::make_unique<Formatter__>();
+	Prototype__.CopySettingsTo__(Formatter->Manager);
+	return Formatter;
+}
+
+template<typename OutType, typename StringType>
+void OrderedOutput<OutType, StringType> ::Release__(std::unique_ptr<Formatter__> Formatter) {
+	std::lock_guard<std::mutex> Guard(IdleLock__);
+	Idle__.push_back(std::move(Formatter));
+}
+
+template<typename OutType, typename StringType>
+bool OrderedOutput<OutType, StringType> ::Full__() const {
+	return Limits__ && Limits__->MemoryCap && Limits__->Pending >= Limits__->MemoryCap;
+}
+
+template<typename OutType, typename StringType>
+void OrderedOutput<OutType, StringType> ::Spill__(Slot__& Slot) {
+	if (!SpillFile__) {
+		SpillFile__.reset(std::tmpfile());
+	}
+	//Without a usable temporary file the slot simply stays in memory.
+	if (!SpillFile__ || !Slot.Text.Size() || std::fseek(SpillFile__.get(), 0, SEEK_END)) {
+		return;
+	}
+	const long Offset = std::ftell(SpillFile__.get());
+	if (Offset >= 0 && std::fwrite(Slot.Text.Data(), sizeof(Char__), Slot.Text.Size(), SpillFile__.get()) == Slot.Text.Size()) {
+		Slot.Offset = Offset;
+		Slot.Length = Slot.Text.Size();
+		Limits__->Pending -= Slot.Text.Size() * sizeof(Char__);
+		Slot.Text.Release();
+	}
+}
+
+template<typename OutType, typename StringType>
+void OrderedOutput<OutType, StringType> ::Emit__(bool All) {
+	for (; Next__ < Slots__.size() && (All || Slots__[Next__].Done); ++Next__) {
+		Slot__& Slot = Slots__[Next__];
+		if (Slot.Offset >= 0) {
+			//Read back in blocks, so draining does not need the memory the spill saved.
+			const size_t Block = Manager__.BlockLength__(1);
+			if (!ReadBack__) {
+				ReadBack__.reset(new Char__[Block]);
+			}
+			std::fflush(SpillFile__.get());
+			for (size_t Done = 0; Done < Slot.Length;) {
+				size_t Count = 0;
+				if (!std::fseek(SpillFile__.get(), Slot.Offset + long(Done * sizeof(Char__)), SEEK_SET)) {
+					Count = std::fread(ReadBack__.get(), sizeof(Char__), std::min(Block, Slot.Length - Done), SpillFile__.get());
+				}
+				if (!Count) {
+					throw std::runtime_error("OrderedOutput: cannot read back the spill file");
+				}
+				Manager__.OutStream__.write(ReadBack__.get(), Count);
+				Done += Count;
+			}
+			Slot.Offset = -1;
+		}
+		Manager__.OutStream__.write(Slot.Text.Data(), Slot.Text.Size());
+		if (Limits__) {
+			Limits__->Pending -= Slot.Text.Size() * sizeof(Char__);
+		}
+		//Written slots are freed, so a long loop only holds the lines waiting for an earlier iteration.
+		Slot.Text.Release();
+	}
+	Room__.notify_all();
+}
+
+#endif
@@ -0,0 +1,11 @@
+/**
+ * @file
+ * @brief Instantiates the common OutputManager types once, for programs built with `OUTPUTMANAGER_EXTERN_TEMPLATES`.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManagerConsole.h"
+
+template class OutputManager<std::wostream, std::wstring>;
+template class OutputManager<std::ostream, std::string>;
@@ -0,0 +1,32 @@
+#ifndef OUTPUTMANAGERCONSOLE_H
+#define OUTPUTMANAGERCONSOLE_H
+
+/**
+ * @file
+ * @brief The standard output streams the OutputManager constructors without a stream write to.
+ *
+ * @details Include this header, rather than OutputManager.h alone, to construct an OutputManager without a stream. It is the only one of the library which includes `<iostream>`.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include <iostream>
+#include "OutputManager.h"
+
+namespace OutputManagerDetail {
+	template<typename OutType> struct StandardStream {
+		/**
+		 * @brief `std::wcout` for wide streams, `std::cout` for narrow ones.
+		 */
+		static OutType& Get() {
+			if constexpr (std::is_same_v<typename OutType::char_type, char>) {
+				return std::cout;
+			}
+			else {
+				return std::wcout;
+			}
+		}
+	};
+}
+
+#endif
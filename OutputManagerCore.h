@@ -0,0 +1,2275 @@
+#ifndef OUTPUTMANAGERCORE_H
+#define OUTPUTMANAGERCORE_H
+
+/**
+ * @file
+ * @brief The OutputManager class without `<iostream>` and `<iomanip>`.
+ *
+ * @details Works with any stream passed to the constructors. The constructors that default to the standard output are defined in OutputManager.h and need OutputManagerConsole.h, which names `std::wcout` and `std::cout`.
+ * @details Threads, the spill file and the SIMD kernels are left to OutputManagerParallel.h and OutputManagerSimd.h, so that code printing serially does not parse them.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ * @date 28-10-2021
+ * @version 0.8.1
+ */
+
+#include <ios>
+#include <ostream>
+#include <atomic>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <cstring>
+#include <charconv>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cwchar>
+#include <ctime>
+
+/**
+ * @brief Customisation point to print a type straight into the output buffer, bypassing `operator<<`.
+ *
+ * @details The primary template is empty, so every type is printed with `operator<<` by default. A specialisation must provide two static functions:
+ * - `size_t size_hint(T const& Value)`, an upper bound on the number of characters written for `Value`;
+ * - `CharT* format_to(CharT* Out, T const& Value)`, which writes `Value` starting at `Out` and returns the end of the written characters. It can be a template on `CharT`, or take a plain `char*`, in which case the output is widened with the locale of the stream.
+ *
+ * Width and alignment are applied by OutputManager, so `format_to` must only write the value itself.
+ * A specialisation can also declare `static constexpr size_t max_length`, an upper bound valid for every value, which lets the range and column printers reserve the output for many elements at once.
+ *
+ * **Example:**
+ * ```.cpp
+ * struct Point {int X, Y;};
+ *
+ * template<> struct OutputFormatter<Point> {
+ *     static size_t size_hint(Point const&) {return 25;}
+ *     static char* format_to(char* Out, Point const& P) {
+ *         return Out + std::sprintf(Out, "(%d,%d)", P.X, P.Y);
+ *     }
+ * };
+ * ```
+ * @tparam T The type to format.
+ */
+template<typename T> struct OutputFormatter {};
+
+/**
+ * @brief A string known at compile time, which takes no space and is copied with immediate stores.
+ *
+ * @details Provides the `size()` and `data()` members OutputManager uses on separators and ends of line. Used through StaticSeparators.
+ * @tparam CharT The character type.
+ * @tparam Characters The characters of the string.
+ */
+template<typename CharT, CharT... Characters> struct Literal {
+	static constexpr CharT Text[sizeof...(Characters) + 1] = {Characters..., CharT(0)};
+	static constexpr size_t size() {
+		return sizeof...(Characters);
+	}
+	static constexpr CharT const* data() {
+		return Text;
+	}
+};
+
+/**
+ * @brief Used as the `StringType` of an OutputManager, fixes its separator and end of line at compile time.
+ *
+ * @details The separator and end of line are then static members, which take no space in the OutputManager. Every copy of them has a length known to the compiler, so it becomes a few immediate stores instead of a loop over a runtime string.
+ *
+ * **Example:**
+ * ```.cpp
+ * #include "OutputManager.h"
+ * #include <iostream>
+ *
+ * int main () {
+ *     OutputManager<std::wostream, CommaSeparated<>> O(std::wcout);
+ *     O(1, 2.5, L"Salmon");
+ * }
+ * ```
+ * **Output:**
+ * ```
+ * 1,2.5,Salmon
+ * ```
+ * @tparam Separator A Literal, the separator.
+ * @tparam EndOfLine A Literal, the end of line.
+ * @warning SetSeparator(StringType&&) and SetEndOfLine(StringType&&) cannot be used.
+ */
+template<typename Separator, typename EndOfLine> struct StaticSeparators {};
+/**
+ * @brief Fields separated by a space, lines ended by a newline.
+ */
+template<typename CharT = wchar_t> using SpaceSeparated = StaticSeparators<Literal<CharT, CharT(' ')>, Literal<CharT, CharT('\n')>>;
+/**
+ * @brief Fields separated by a comma, lines ended by a newline.
+ */
+template<typename CharT = wchar_t> using CommaSeparated = StaticSeparators<Literal<CharT, CharT(',')>, Literal<CharT, CharT('\n')>>;
+/**
+ * @brief Fields separated by a tab, lines ended by a newline.
+ */
+template<typename CharT = wchar_t> using TabSeparated = StaticSeparators<Literal<CharT, CharT('\t')>, Literal<CharT, CharT('\n')>>;
+
+/**
+ * @brief Implementation details shared by the `OutputManager` printers.
+ */
+namespace OutputManagerDetail {
+	/**
+	 * @brief Tells if `OutputFormatter<T>` can write directly to a `CharT` buffer.
+	 */
+	template<typename T, typename CharT, typename = void> struct FormatsTo : std::false_type {};
+	template<typename T, typename CharT> struct FormatsTo<T, CharT, std::void_t<decltype(OutputFormatter<T>::format_to(std::declval<CharT*>(), std::declval<T const&>()))>> : std::true_type {};
+	/**
+	 * @brief Tells if `OutputFormatter<T>` provides a `size_hint`.
+	 */
+	template<typename T, typename = void> struct HasSizeHint : std::false_type {};
+	template<typename T> struct HasSizeHint<T, std::void_t<decltype(OutputFormatter<T>::size_hint(std::declval<T const&>()))>> : std::true_type {};
+	/**
+	 * @brief Tells if `T` is printed through a specialisation of `OutputFormatter` on a stream of `CharT`.
+	 */
+	template<typename T, typename CharT> constexpr bool HasOutputFormatter = HasSizeHint<T>::value && (FormatsTo<T, CharT>::value || FormatsTo<T, char>::value);
+	/**
+	 * @brief Tells if `OutputFormatter<T>` declares a `max_length` valid for every value.
+	 */
+	template<typename T, typename = void> struct HasMaxLength : std::false_type {};
+	template<typename T> struct HasMaxLength<T, std::void_t<decltype(OutputFormatter<T>::max_length)>> : std::true_type {};
+
+	/**
+	 * @brief Builds the default separator or end of line from ASCII text, for any character type.
+	 */
+	template<typename Text> Text DefaultText(const char* Value) {
+		Text Result;
+		for (; *Value; ++Value) {
+			Result.push_back(static_cast<typename Text::value_type>(*Value));
+		}
+		return Result;
+	}
+	/**
+	 * @brief The separator and end of line of an OutputManager with the given `StringType`, a base of OutputManager.
+	 */
+	template<typename StringType> struct Separators {
+		static constexpr bool Static = false;
+		/**
+		 * @brief See OutputManager::Separator__.
+		 */
+		StringType Separator__;
+		/**
+		 * @brief See OutputManager::EndOfLine__.
+		 */
+		StringType EndOfLine__;
+		Separators() : Separator__{DefaultText<StringType>(" ")}, EndOfLine__{DefaultText<StringType>("\n")} {
+		}
+		Separators(StringType&& Separator, StringType&& EndOfLine) : Separator__{std::move(Separator)}, EndOfLine__{std::move(EndOfLine)} {
+		}
+	};
+	/**
+	 * @brief The literals of StaticSeparators, as static members so that the base is empty.
+	 */
+	template<typename S, typename E> struct Separators<StaticSeparators<S, E>> {
+		static constexpr bool Static = true;
+		static constexpr S Separator__{};
+		static constexpr E EndOfLine__{};
+		Separators() = default;
+		Separators(StaticSeparators<S, E>&&, StaticSeparators<S, E>&&) {
+		}
+	};
+
+	/**
+	 * @brief `A + B`, or the largest `size_t` if the sum does not fit, so that length bounds never wrap around to a small reservation.
+	 */
+	constexpr size_t AddSaturated(size_t A, size_t B) {
+		return A > std::numeric_limits<size_t>::max() - B ? std::numeric_limits<size_t>::max() : A + B;
+	}
+
+	/**
+	 * @brief Tells if `T` is an integer that `operator<<` prints as a number, so neither `bool` nor a character type.
+	 */
+	template<typename T> constexpr bool IsNumericInteger = std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char> && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+	/**
+	 * @brief Tells if `T` is a string of `CharT`, printed by copying its characters.
+	 */
+	template<typename T, typename CharT> struct IsString : std::false_type {};
+	template<typename CharT, typename Allocator> struct IsString<std::basic_string<CharT, std::char_traits<CharT>, Allocator>, CharT> : std::true_type {};
+	template<typename CharT> struct IsString<std::basic_string_view<CharT>, CharT> : std::true_type {};
+	template<typename CharT> struct IsString<CharT*, CharT> : std::true_type {};
+	template<typename CharT> struct IsString<CharT const*, CharT> : std::true_type {};
+	template<typename CharT, size_t N> struct IsString<CharT[N], CharT> : std::true_type {};
+
+	/**
+	 * @brief Pairs of decimal digits, from `"00"` to `"99"`.
+	 */
+	inline constexpr char DigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+	/**
+	 * @brief Writes `Value` in base 10.
+	 * @return The end of the written characters.
+	 */
+	template<typename CharT, typename T> CharT* FormatDecimal(CharT* Out, T Value) {
+		using Unsigned = std::make_unsigned_t<T>;
+		Unsigned Magnitude = static_cast<Unsigned>(Value);
+		if constexpr (std::is_signed_v<T>) {
+			if (Value < 0) {
+				*Out++ = CharT('-');
+				Magnitude = Unsigned(0) - Magnitude;
+			}
+		}
+		CharT Digits[std::numeric_limits<Unsigned>::digits10 + 1];
+		CharT* Cursor = std::end(Digits);
+		while (Magnitude >= 100) {
+			const unsigned Pair = static_cast<unsigned>(Magnitude % 100) * 2;
+			Magnitude /= 100;
+			*--Cursor = CharT(DigitPairs[Pair + 1]);
+			*--Cursor = CharT(DigitPairs[Pair]);
+		}
+		if (Magnitude >= 10) {
+			const unsigned Pair = static_cast<unsigned>(Magnitude) * 2;
+			*--Cursor = CharT(DigitPairs[Pair + 1]);
+			*--Cursor = CharT(DigitPairs[Pair]);
+		}
+		else {
+			*--Cursor = CharT('0' + Magnitude);
+		}
+		return std::copy(Cursor, std::end(Digits), Out);
+	}
+
+	/**
+	 * @brief Pairs of lowercase hexadecimal digits, one for every byte value.
+	 */
+	inline constexpr char HexPairs[] = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9fa0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebfc0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+	/**
+	 * @brief Pairs of uppercase hexadecimal digits, one for every byte value.
+	 */
+	inline constexpr char UpperHexPairs[] = "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9FA0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBFC0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDFE0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+	/**
+	 * @brief The four binary digits of every nibble.
+	 */
+	inline constexpr char BinaryNibbles[] = "0000000100100011010001010110011110001001101010111100110111101111";
+	/**
+	 * @brief Pairs of octal digits, one for every six bit value.
+	 */
+	inline constexpr char OctalPairs[] = "00010203040506071011121314151617202122232425262730313233343536374041424344454647505152535455565760616263646566677071727374757677";
+	/**
+	 * @brief The number of digits of the widest value of `T` in base `2^Bits`.
+	 */
+	template<typename T> constexpr int BaseDigits(int Bits) {
+		return (std::numeric_limits<std::make_unsigned_t<T>>::digits + Bits - 1) / Bits;
+	}
+	/**
+	 * @brief Writes `Value` in base 2, 8 or 16 with lookup tables, as the unsigned value with the same bits, like `std::hex` and `std::oct` do.
+	 * @param Base The base, `2`, `8` or `16`.
+	 * @param Pad If `true` the value is padded with zeros to the width of `T`.
+	 * @param Upper If `true` hexadecimal digits are uppercase.
+	 * @return The end of the written characters.
+	 */
+	template<typename CharT, typename T> CharT* FormatBase(CharT* Out, T Value, unsigned Base, bool Pad, bool Upper) {
+		using Unsigned = std::make_unsigned_t<T>;
+		//Promoted, so that shifting by a whole byte is always defined.
+		unsigned long long Bits = static_cast<Unsigned>(Value);
+		const int Shift = Base == 16 ? 4 : Base == 8 ? 3 : 1;
+		int Digits = BaseDigits<T>(Shift);
+		if (!Pad) {
+			Digits = 1;
+			for (unsigned long long Rest = Bits >> Shift; Rest; Rest >>= Shift) {
+				++Digits;
+			}
+		}
+		CharT* Cursor = Out + Digits;
+		int Left = Digits;
+		if (Base == 16) {
+			const char* Pairs = Upper ? UpperHexPairs : HexPairs;
+			for (; Left >= 2; Left -= 2, Bits >>= 8) {
+				const char* Pair = Pairs + 2 * (Bits & 0xFF);
+				*--Cursor = CharT(Pair[1]);
+				*--Cursor = CharT(Pair[0]);
+			}
+			if (Left) {
+				*--Cursor = CharT(Pairs[2 * (Bits & 0xF) + 1]);
+			}
+		}
+		else if (Base == 8) {
+			for (; Left >= 2; Left -= 2, Bits >>= 6) {
+				const char* Pair = OctalPairs + 2 * (Bits & 0x3F);
+				*--Cursor = CharT(Pair[1]);
+				*--Cursor = CharT(Pair[0]);
+			}
+			if (Left) {
+				*--Cursor = CharT('0' + (Bits & 0x7));
+			}
+		}
+		else {
+			for (; Left >= 4; Left -= 4, Bits >>= 4) {
+				Cursor -= 4;
+				std::copy_n(BinaryNibbles + 4 * (Bits & 0xF), 4, Cursor);
+			}
+			for (; Left; --Left, Bits >>= 1) {
+				*--Cursor = CharT('0' + (Bits & 1));
+			}
+		}
+		return Out + Digits;
+	}
+
+	/**
+	 * @brief Writes two hexadecimal digits for each of the `Count` bytes at `In`, one byte at a time with HexPairs.
+	 * @param Upper If `true` the digits are uppercase.
+	 */
+	inline void HexBytesScalar(char* Out, unsigned char const* In, size_t Count, bool Upper) {
+		const char* Pairs = Upper ? UpperHexPairs : HexPairs;
+		for (size_t i = 0; i < Count; ++i) {
+			std::memcpy(Out + 2 * i, Pairs + 2 * In[i], 2);
+		}
+	}
+	/**
+	 * @brief A kernel writing two hexadecimal digits for each of the `Count` bytes at `In`.
+	 */
+	using HexKernel = void (*)(char* Out, unsigned char const* In, size_t Count, bool Upper);
+	/**
+	 * @brief Picks the widest kernel the CPU supports: set by OutputManagerSimd.h if it is included anywhere in the program, `nullptr` otherwise.
+	 */
+	inline HexKernel (*HexBytesPicker)() = nullptr;
+	inline void HexBytesBind(char* Out, unsigned char const* In, size_t Count, bool Upper);
+	/**
+	 * @brief The kernel HexBytes() runs: HexBytesBind() until the first call binds the kernel HexBytesPicker picks, or HexBytesScalar() without it.
+	 */
+	inline std::atomic<HexKernel> HexBytesKernel{HexBytesBind};
+	/**
+	 * @brief Binds HexBytesKernel on the first call, then runs it.
+	 * @details Threads racing on the first call all bind the same kernel.
+	 */
+	inline void HexBytesBind(char* Out, unsigned char const* In, size_t Count, bool Upper) {
+		const HexKernel Kernel = HexBytesPicker ? HexBytesPicker() : HexBytesScalar;
+		HexBytesKernel.store(Kernel, std::memory_order_relaxed);
+		Kernel(Out, In, Count, Upper);
+	}
+	/**
+	 * @brief Writes two hexadecimal digits for each of the `Count` bytes at `In`, with HexBytesKernel.
+	 * @param Upper If `true` the digits are uppercase.
+	 */
+	inline void HexBytes(char* Out, unsigned char const* In, size_t Count, bool Upper) {
+		HexBytesKernel.load(std::memory_order_relaxed)(Out, In, Count, Upper);
+	}
+
+	/**
+	 * @brief The formatting options of a single column.
+	 * @tparam CharT The character type.
+	 */
+	template<typename CharT> struct ColumnFormat {
+		/**
+		 * @brief The thousands separator, `0` if digits are not grouped.
+		 */
+		CharT Grouping = CharT(0);
+		/**
+		 * @brief `0` for plain numbers, positive for IEC size units, negative for SI size units.
+		 */
+		int Units = 0;
+	};
+	/**
+	 * @brief Inserts `Separator` between every three digits of the first run of digits in `[Begin, End)`, after an optional sign.
+	 * @warning There must be room for one more character every three digits after `End`.
+	 * @return The new end of the characters.
+	 */
+	template<typename CharT> CharT* GroupThousands(CharT* Begin, CharT* End, CharT Separator) {
+		CharT* First = Begin;
+		if (First != End && (*First == CharT('-') || *First == CharT('+'))) {
+			++First;
+		}
+		CharT* Last = First;
+		while (Last != End && *Last >= CharT('0') && *Last <= CharT('9')) {
+			++Last;
+		}
+		const size_t Digits = Last - First;
+		if (Digits <= 3) {
+			return End;
+		}
+		const size_t Extra = (Digits - 1) / 3;
+		std::copy_backward(Last, End, End + Extra);
+		CharT* Read = Last;
+		CharT* Write = Last + Extra;
+		for (size_t Count = 1; Read != First; ++Count) {
+			*--Write = *--Read;
+			if (Count % 3 == 0 && Read != First) {
+				*--Write = Separator;
+			}
+		}
+		return End + Extra;
+	}
+	/**
+	 * @brief `std::signbit` for `double`, which would need `<cmath>`.
+	 */
+	inline bool SignBit(double Value) {
+		uint64_t Bits;
+		std::memcpy(&Bits, &Value, sizeof(Bits));
+		return Bits >> 63;
+	}
+	/**
+	 * @brief `std::fabs` for `double`, which would need `<cmath>`.
+	 */
+	inline double Magnitude(double Value) {
+		return SignBit(Value) ? -Value : Value;
+	}
+	/**
+	 * @brief Writes `Value` as a size with a unit, like `12.3 MiB`.
+	 *
+	 * @details The value is divided by the unit base until it is smaller than it, up to exabytes, and written with one decimal. Values smaller than the base are written as they are for integers, with one decimal for floating point numbers, followed by ` B`.
+	 * @param Units If positive the units are IEC (`KiB`, `MiB`, ...) and powers of 1024, if negative they are SI (`kB`, `MB`, ...) and powers of 1000.
+	 * @warning There must be room for 24 characters at `Out` for integers, 400 for floating point numbers.
+	 * @return The end of the written characters.
+	 */
+	template<typename T> char* FormatUnits(char* Out, T Value, int Units) {
+		constexpr const char* Iec[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB"};
+		constexpr const char* Si[] = {"B", "kB", "MB", "GB", "TB", "PB", "EB"};
+		const double Base = Units > 0 ? 1024.0 : 1000.0;
+		double Scaled = Magnitude(static_cast<double>(Value));
+		int Unit = 0;
+		while (Unit < 6 && Scaled >= Base) {
+			Scaled /= Base;
+			++Unit;
+		}
+		//Values which would round up to the base move to the next unit.
+		if (Unit && Unit < 6 && Scaled >= Base - 0.05) {
+			Scaled /= Base;
+			++Unit;
+		}
+		if constexpr (std::is_integral_v<T>) {
+			if (!Unit) {
+				Out = FormatDecimal(Out, Value);
+			}
+		}
+		if (Unit || std::is_floating_point_v<T>) {
+			if (SignBit(static_cast<double>(Value))) {
+				*Out++ = '-';
+			}
+			Out = std::to_chars(Out, Out + 400, Scaled, std::chars_format::fixed, 1).ptr;
+		}
+		*Out++ = ' ';
+		const char* Name = Units > 0 ? Iec[Unit] : Si[Unit];
+		const size_t Length = std::strlen(Name);
+		return std::copy(Name, Name + Length, Out);
+	}
+
+	/**
+	 * @brief The largest precision handled by FormatFixed(CharT*, double, int).
+	 */
+	inline constexpr int MaxFixedPrecision = 9;
+	/**
+	 * @brief Writes `Value` in fixed notation with `Precision` decimals, with the same rounding as `printf("%.*f")`.
+	 *
+	 * @details The value is scaled by `10^Precision` and rounded to an integer, whose digits are then written with the decimal point in place. The scaled product carries an error of at most half an ulp, so whenever its fractional part lies further than that from one half, it rounds to the same integer as the exact value would. Values too close to a tie, too large for the integer, or not finite are left to the caller.
+	 * @param Precision The number of decimals, at most MaxFixedPrecision.
+	 * @return The end of the written characters, or `nullptr` if the value must be formatted another way.
+	 */
+	template<typename CharT> CharT* FormatFixed(CharT* Out, double Value, int Precision) {
+		constexpr double Scales[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+		constexpr uint64_t IntegerScales[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+		const double Scaled = Magnitude(Value) * Scales[Precision];
+		//Also false for NaN.
+		if (!(Scaled < 0x1p53)) {
+			return nullptr;
+		}
+		//Truncation is the floor of a non negative value.
+		const uint64_t Floor = static_cast<uint64_t>(Scaled);
+		const double Fraction = Scaled - static_cast<double>(Floor);
+		if (Magnitude(Fraction - 0.5) <= Scaled * 0x1p-52) {
+			return nullptr;
+		}
+		const uint64_t Rounded = Floor + (Fraction > 0.5);
+		if (SignBit(Value)) {
+			*Out++ = CharT('-');
+		}
+		Out = FormatDecimal(Out, Rounded / IntegerScales[Precision]);
+		if (Precision) {
+			*Out++ = CharT('.');
+			uint64_t Decimals = Rounded % IntegerScales[Precision];
+			for (int i = Precision - 1; i >= 0; --i) {
+				Out[i] = CharT('0' + Decimals % 10);
+				Decimals /= 10;
+			}
+			Out += Precision;
+		}
+		return Out;
+	}
+
+	/**
+	 * @brief The timestamp put before every line, see OutputManager::SetTimestamp(std::string const&, unsigned, bool).
+	 * @tparam CharT The character type.
+	 */
+	template<typename CharT> struct Timestamp {
+		/**
+		 * @brief The `std::strftime` format of the part up to the second.
+		 */
+		std::string Format;
+		/**
+		 * @brief The number of digits of the fraction of a second.
+		 */
+		unsigned Digits = 0;
+		/**
+		 * @brief `true` to read the coarse clock.
+		 */
+		bool Coarse = false;
+		/**
+		 * @brief The second `Text` was formatted for, `-1` if none yet.
+		 */
+		std::time_t Second = -1;
+		/**
+		 * @brief The part up to the second, widened, and its length.
+		 */
+		CharT Text[64];
+		size_t Length = 0;
+	};
+
+	/**
+	 * @brief A growable character buffer which can be written to through raw pointers.
+	 *
+	 * @details Reserve(size_t) returns a cursor with room for at least the requested number of characters, the caller writes through it and then calls Commit(CharT*) with the end of what was written. Unlike `std::basic_string`, nothing is initialised before being written. Also holds the column formats, which are trivially copyable as well.
+	 * @tparam CharT The character type.
+	 */
+	template<typename CharT> class OutputBuffer {
+		private:
+			CharT* Data__ = nullptr;
+			size_t Size__ = 0;
+			size_t Capacity__ = 0;
+
+		public:
+			OutputBuffer() = default;
+			OutputBuffer(OutputBuffer&& Other) noexcept : Data__{Other.Data__}, Size__{Other.Size__}, Capacity__{Other.Capacity__} {
+				Other.Data__ = nullptr;
+				Other.Size__ = 0;
+				Other.Capacity__ = 0;
+			}
+			OutputBuffer& operator=(OutputBuffer&& Other) noexcept {
+				std::swap(Data__, Other.Data__);
+				std::swap(Size__, Other.Size__);
+				std::swap(Capacity__, Other.Capacity__);
+				return *this;
+			}
+			~OutputBuffer() {
+				delete[] Data__;
+			}
+			/**
+			 * @brief Makes room for `Extra` more characters.
+			 * @return A pointer to the first free character.
+			 * @throw std::bad_alloc If the buffer cannot hold that many characters, before anything is written.
+			 */
+			CharT* Reserve(size_t Extra) {
+				if (Capacity__ - Size__ < Extra) {
+					if (Extra > size_t(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(CharT) - Size__) {
+						throw std::bad_alloc();
+					}
+					const size_t NewCapacity = std::max(Size__ + Extra, 2 * Capacity__ + 64);
+					CharT* NewData = new CharT[NewCapacity];
+					if (Size__) {
+						std::memcpy(NewData, Data__, Size__ * sizeof(CharT));
+					}
+					delete[] Data__;
+					Data__ = NewData;
+					Capacity__ = NewCapacity;
+				}
+				return Data__ + Size__;
+			}
+			/**
+			 * @brief Marks everything up to `End` as written.
+			 */
+			void Commit(CharT* End) {
+				Size__ = End - Data__;
+			}
+			/**
+			 * @brief Appends `Count` characters.
+			 */
+			void Append(CharT const* Text, size_t Count) {
+				CharT* Out = Reserve(Count);
+				if (Count) {
+					std::memcpy(Out, Text, Count * sizeof(CharT));
+				}
+				Size__ += Count;
+			}
+			/**
+			 * @brief Appends `Count` copies of `Fill`.
+			 */
+			void Append(size_t Count, CharT Fill) {
+				std::fill_n(Reserve(Count), Count, Fill);
+				Size__ += Count;
+			}
+			CharT* Data() {
+				return Data__;
+			}
+			CharT const* Data() const {
+				return Data__;
+			}
+			size_t Size() const {
+				return Size__;
+			}
+			size_t Capacity() const {
+				return Capacity__;
+			}
+			void Clear() {
+				Size__ = 0;
+			}
+			/**
+			 * @brief Drops everything after the first `Length` characters, if there are more.
+			 */
+			void Truncate(size_t Length) {
+				Size__ = std::min(Size__, Length);
+			}
+			/**
+			 * @brief Empties the buffer and frees its memory.
+			 */
+			void Release() {
+				delete[] Data__;
+				Data__ = nullptr;
+				Size__ = 0;
+				Capacity__ = 0;
+			}
+	};
+
+	/**
+	 * @brief Prints in rows for OutputManager::ParallelFormatToRows(It, It, Its...), as a friend of OutputManager. Only defined in OutputManagerParallel.h.
+	 * @tparam It The iterator type, which makes every use dependent so that a missing OutputManagerParallel.h is a compile error rather than a link error.
+	 */
+	template<typename It> struct ParallelRows;
+
+	/**
+	 * @brief The memory cap and the parallel settings of an OutputManager, allocated only once one of them is used.
+	 */
+	struct Limits {
+		/**
+		 * @brief The number of threads used by the parallel printers, `0` for `std::thread::hardware_concurrency()`.
+		 */
+		size_t Workers = 0;
+		/**
+		 * @brief The number of bytes the internal buffers may hold, `0` for no limit.
+		 */
+		size_t MemoryCap = 0;
+		/**
+		 * @brief What the parallel printers do with results beyond `MemoryCap`. If positive they are spilled to a temporary file, otherwise the workers wait.
+		 */
+		int Overflow = 0;
+		/**
+		 * @brief The bytes held by finished chunks of the parallel printers which are not written out yet.
+		 */
+		std::atomic<size_t> Pending{0};
+		/**
+		 * @brief The largest number of bytes held by the internal buffers so far.
+		 */
+		std::atomic<size_t> Peak{0};
+	};
+
+	/**
+	 * @brief Owns an object allocated with `new`, like `std::unique_ptr` with the same member names, without parsing `<memory>`.
+	 */
+	template<typename T> class Owned {
+		private:
+			T* Pointer__ = nullptr;
+
+		public:
+			Owned() = default;
+			explicit Owned(T* Pointer) : Pointer__{Pointer} {
+			}
+			Owned(Owned&& Other) noexcept : Pointer__{Other.release()} {
+			}
+			Owned& operator=(Owned&& Other) noexcept {
+				reset(Other.release());
+				return *this;
+			}
+			~Owned() {
+				delete Pointer__;
+			}
+			T* get() const {
+				return Pointer__;
+			}
+			T* release() {
+				T* Pointer = Pointer__;
+				Pointer__ = nullptr;
+				return Pointer;
+			}
+			void reset(T* Pointer = nullptr) {
+				T* Old = Pointer__;
+				Pointer__ = Pointer;
+				delete Old;
+			}
+			T* operator->() const {
+				return Pointer__;
+			}
+			T& operator*() const {
+				return *Pointer__;
+			}
+			explicit operator bool() const {
+				return Pointer__;
+			}
+	};
+
+	/**
+	 * @brief A snapshot of the formatting state of the stream of an OutputManager.
+	 * @tparam CharT The character type.
+	 */
+	template<typename CharT> struct FormatState {
+		/**
+		 * @brief `true` if the built-in kernels format numbers exactly as `operator<<` would.
+		 */
+		bool Numeric = false;
+		/**
+		 * @brief `true` if `std::uppercase` is set, used for hexadecimal digits.
+		 */
+		bool Upper = false;
+		std::ios_base::fmtflags Adjust = std::ios_base::left;
+		CharT Fill = CharT(' ');
+		std::chars_format FloatFormat = std::chars_format::general;
+		int Precision = 6;
+	};
+
+	/**
+	 * @brief What few OutputManager objects use: the column formats, the timestamp and the limits, allocated only once one of them is set.
+	 * @tparam CharT The character type.
+	 */
+	template<typename CharT> struct Extras {
+		/**
+		 * @brief The formatting options of the columns that have any, by position on the line. Columns beyond its end are printed plainly.
+		 * @see OutputManager::SetGrouping(size_t, CharT)
+		 * @see OutputManager::SetUnits(size_t, int)
+		 */
+		OutputBuffer<ColumnFormat<CharT>> Columns;
+		/**
+		 * @brief The timestamp put before every line, `nullptr` if lines are not stamped.
+		 * @see OutputManager::SetTimestamp(std::string const&, unsigned, bool)
+		 */
+		Owned<OutputManagerDetail::Timestamp<CharT>> Timestamp;
+		/**
+		 * @brief The memory cap and the parallel settings, `nullptr` until OutputManager::SetMemoryCap(size_t, int) or OutputManager::SetWorkers(size_t) is called or a parallel printer runs.
+		 */
+		Owned<OutputManagerDetail::Limits> Limits;
+	};
+}
+
+template<typename OutType, typename StringType> class CachedTable;
+template<typename OutType, typename StringType> class OrderedOutput;
+
+/**
+ * @brief This class is used to easily format output.
+ * 
+ * @details OutputManager is a class used to simply manage output with various pre-built functions to format many types of printable data.
+ * @details The main inspiration is the `print()` function from the python programming language, after which I developed some form of Stockholm syndrome.
+ * @tparam OutType The type of the output stream.
+ * @tparam StringType The type of the separator and and of line strings, or StaticSeparators to fix both at compile time.
+ * @warning `StringType` must be compatible with `OutType`.
+ */
+template<typename OutType = std::wostream, typename StringType = std::wstring> class OutputManager : protected OutputManagerDetail::Separators<StringType> {
+	template<typename, typename> friend class OutputManager;
+	template<typename, typename> friend class CachedTable;
+	template<typename, typename> friend class OrderedOutput;
+	friend class DeferredLog;
+	friend class DeferredLogDecoder;
+	template<typename> friend struct OutputManagerDetail::ParallelRows;
+	protected:
+		/**
+		 * @brief The stream type used for in-memory buffers, such as the per-row buffers of ParallelFormatToRows(It, It, Its...).
+		 */
+		using BufferStream__ = std::basic_ostream<typename OutType::char_type, typename OutType::traits_type>;
+		/**
+		 * @brief The character type of `OutType`.
+		 */
+		using Char__ = typename OutType::char_type;
+		/**
+		 * @brief A reference to any output stream, that will be used to write to. Default is `std::wcout`.
+		 */
+		OutType& OutStream__;
+		/**
+		 * @brief The base holding `Separator__` and `EndOfLine__`, empty for StaticSeparators.
+		 */
+		using Separators__ = OutputManagerDetail::Separators<StringType>;
+		/**
+		 * @brief The separator character between various outputs on the same line. Default is `L" "`.
+		 *
+		 * @details This string is automatically inserted between each printed element on the same line. A static member for StaticSeparators.
+		 * @see SetSeparator(StringType&&)
+		 */
+		using Separators__::Separator__;
+		/**
+		 * @brief The character at the end of a line. Default is `L"\n"`.
+		 *
+		 * @details This string is automatically inserted between each printed line. A static member for StaticSeparators.
+		 * @see SetEndOfLine(StringType&&)
+		 */
+		using Separators__::EndOfLine__;
+		/**
+		 * @brief The minimum width of the output, used to format columns if needed. Default is `0`.
+		 * @see SetWidth(size_t)
+		 */
+		size_t Width__ = 0;
+		/**
+		 * @brief The formatting options of a single column.
+		 */
+		using ColumnFormat__ = OutputManagerDetail::ColumnFormat<Char__>;
+		/**
+		 * @brief The number of characters the range and column printers format before writing `Buffer__` out.
+		 */
+		static constexpr size_t BlockSize__ = 1 << 16;
+		/**
+		 * @brief The largest precision handled by the built-in floating point formatting, beyond it `operator<<` is used.
+		 */
+		static constexpr int MaxFloatPrecision__ = 128;
+		/**
+		 * @brief Formatted text waiting to be written to the stream.
+		 *
+		 * @details Printers append to it and write it out with Flush__() before returning, so it is always empty between calls.
+		 */
+		OutputManagerDetail::OutputBuffer<Char__> Buffer__;
+		/**
+		 * @brief The column formats, the timestamp and the limits, `nullptr` until one of them is set, so that constructing an OutputManager allocates nothing.
+		 * @see Extend__()
+		 */
+		OutputManagerDetail::Owned<OutputManagerDetail::Extras<Char__>> Extras__;
+		/**
+		 * @brief The formatting state used by the current printer.
+		 * @see Refresh__()
+		 */
+		OutputManagerDetail::FormatState<Char__> State__;
+		/**
+		 * @brief The base integers are printed in. Default is `10`.
+		 * @see SetBase(unsigned, bool)
+		 */
+		unsigned char Base__ = 10;
+		/**
+		 * @brief If `true` integers printed in base 2, 8 or 16 are padded with zeros to the width of their type. Default is `false`.
+		 * @see SetBase(unsigned, bool)
+		 */
+		bool BasePad__ = false;
+
+		/**
+		 * @brief Takes a snapshot of the formatting state of `OutStream__`, called at the start of every printer.
+		 *
+		 * @details Numbers are formatted by the built-in kernels only with the classic locale and without flags they do not implement (`showpos`, `showpoint`, `showbase`, `uppercase`, non decimal bases and `hexfloat`), otherwise `operator<<` is used.
+		 */
+		void Refresh__();
+		/**
+		 * @brief Widens the characters between `Begin` and `End` to `Out` with the locale of `OutStream__`.
+		 * @return The end of the written characters.
+		 */
+		Char__* Widen__(const char* Begin, const char* End, Char__* Out) const;
+		/**
+		 * @brief The formatting options of a column.
+		 * @return The options, or `nullptr` if the column has none.
+		 */
+		ColumnFormat__ const* Format__(size_t Column) const;
+		/**
+		 * @brief Applies the thousands separator of a column, if any, to the number between `Begin` and `End`.
+		 * @return The new end of the number.
+		 */
+		Char__* Group__(Char__* Begin, Char__* End, ColumnFormat__ const* Format) const;
+		/**
+		 * @brief The maximum number of characters written for any value of `T` in a column, without padding.
+		 * @return The bound, or `0` if the length of `T` is unbounded or not known in advance.
+		 */
+		template<typename T> size_t MaxLength__(size_t Column) const;
+		/**
+		 * @brief The maximum number of characters written for a line holding one value of each type, including padding, separators and end of line.
+		 * @return The bound, or `0` if any of the types is unbounded.
+		 */
+		template<typename... T> size_t LineLength__() const;
+		/**
+		 * @brief Writes a single element at `Out` and pads it to `Width__`, without any capacity check.
+		 * @warning There must be room for at least `std::max(Width__, MaxLength__<T>(Column))` characters at `Out`, and `MaxLength__<T>(Column)` must not be `0`.
+		 * @return The end of the written characters.
+		 */
+		template<typename T> Char__* Write__(Char__* Out, T const& Element, size_t Column);
+		/**
+		 * @brief Writes a whole line at `Out`, without any capacity check.
+		 * @warning There must be room for at least `LineLength__<T, P...>()` characters at `Out`, which must not be `0`.
+		 * @return The end of the written characters.
+		 */
+		template<typename T, typename... P> Char__* WriteLine__(Char__* Out, T const& First, P const&... Rest);
+		/**
+		 * @brief Writes a string at `Out`, without any capacity check.
+		 * @return The end of the written characters.
+		 */
+		template<typename Text> Char__* Copy__(Char__* Out, Text const& Value) const;
+		/**
+		 * @brief Pads the characters between `Begin` and `End` to `Width__`.
+		 * 
+		 * @details Follows the alignment of `OutStream__`. With `std::internal` the fill characters of numbers go after the sign, like `operator<<` does.
+		 * @warning There must be room for `Width__` characters at `Begin`.
+		 * @return The end of the padded characters.
+		 */
+		Char__* Pad__(Char__* Begin, Char__* End, bool Numeric) const;
+		/**
+		 * @brief Writes `Count` fill characters at `Out`.
+		 *
+		 * @details Narrow characters are set with `memset` and `wchar_t` with `wmemset`, so both use the wide stores of the C library instead of a loop over characters.
+		 * @return The end of the written characters.
+		 */
+		Char__* Fill__(Char__* Out, size_t Count) const;
+		/**
+		 * @brief Formats a single element into `Buffer__`, applying `Width__` and the alignment of `OutStream__`.
+		 *
+		 * @details Numbers, strings and types with an OutputFormatter specialisation are written straight into `Buffer__`, everything else is printed with `operator<<` after flushing `Buffer__`, and `State__` is then taken again, so that manipulators such as `std::hex` apply to the rest of the line.
+		 * @tparam T A printable type.
+		 */
+		template<typename T> void Put__(T const& Element, size_t Column);
+		/**
+		 * @brief Prints one line holding all the given elements.
+		 *
+		 * @details If every element has a bounded length the whole line is reserved at once and written without further checks, otherwise each element goes through Put__(T const&, size_t).
+		 */
+		template<typename... T> void PrintLine__(T const&... Elements);
+		/**
+		 * @brief Appends one line holding all the given elements to `Buffer__`, with the current `State__` and without flushing.
+		 * @see PrintLine__(T const&...)
+		 */
+		template<typename... T> void AppendLine__(T const&... Elements);
+		/**
+		 * @brief Appends a separator or end of line string to `Buffer__`.
+		 */
+		template<typename Text> void Append__(Text const& Value);
+		/**
+		 * @brief Appends the current time to `Buffer__`, formatting the part up to the second again only when the second changed.
+		 */
+		void AppendTimestamp__();
+		/**
+		 * @brief Starts a non empty line in `Buffer__`: the timestamp followed by `Separator__` if SetTimestamp(std::string const&, unsigned, bool) is on, nothing otherwise.
+		 *
+		 * @details Every printer calls this before the first element of a line, so all of them stamp the same way.
+		 */
+		void StartLine__();
+		/**
+		 * @brief Writes `Buffer__` to `OutStream__` and empties it.
+		 *
+		 * @details If the capacity of `Buffer__` grew beyond the memory cap its memory is released.
+		 */
+		void Flush__();
+		/**
+		 * @brief Flushes `Buffer__` early if it holds more bytes than the memory cap, used by the printers which append element by element.
+		 */
+		void Drain__();
+		/**
+		 * @brief The number of items of `Length` characters a printer formats into `Buffer__` before flushing it, within `BlockSize__` and the memory cap.
+		 */
+		size_t BlockLength__(size_t Length) const;
+		/**
+		 * @brief Raises the peak of the limits to `Bytes` if it is lower.
+		 * @warning Limits__() must not be `nullptr`.
+		 */
+		void Track__(size_t Bytes);
+		/**
+		 * @brief `Extras__`, allocated first if needed.
+		 */
+		OutputManagerDetail::Extras<Char__>& Extend__();
+		/**
+		 * @brief The timestamp, `nullptr` if lines are not stamped.
+		 */
+		OutputManagerDetail::Timestamp<Char__>* Timestamp__() const;
+		/**
+		 * @brief The memory cap and the parallel settings, `nullptr` if none was set.
+		 */
+		OutputManagerDetail::Limits* Limits__() const;
+		/**
+		 * @brief The memory cap and the parallel settings, allocated with their defaults if needed.
+		 */
+		OutputManagerDetail::Limits& MakeLimits__();
+		/**
+		 * @brief Prints all elements in range, each followed by `Separator__`, without `EndOfLine__`.
+		 * @tparam It A forward iterator.
+		 * @param Column The column of the first element.
+		 */
+		template<typename It> void PrintElements__(It Begin, It End, size_t Column = 0);
+		/**
+		 * @brief Copies separators, width and the stream formatting state to another `OutputManager`.
+		 * @tparam Other An `OutputManager` with the same `StringType`.
+		 */
+		template<typename Other> void CopySettingsTo__(Other& Target) const;
+		
+	public:
+		OutputManager(OutputManager const&) = delete;
+    	OutputManager& operator=(OutputManager const &) = delete;
+
+		/**
+		 * @brief The default constructor sets all variables to their default value.
+		 * 
+		 * @note Alignment of text is defaulted to left. To change it use SetAlignment(int).
+		 * @note Writes to `std::wcout`, or `std::cout` for narrow streams, so it needs OutputManagerConsole.h.
+		 */
+		OutputManager();
+		/**
+		 * @brief Only the `OutStream__` attribute is initialised.
+		 * 
+		 * @note Alignment of text is defaulted to left. To change it use SetAlignment(int).
+		 */
+		OutputManager(OutType& OutStream);
+		/**
+		 * @brief Only the `Separator__` and EndOfLine__ attributes are initialised.
+		 * 
+		 * @note Alignment of text is defaulted to left. To change it use SetAlignment(int).
+		 * @note Writes to `std::wcout`, or `std::cout` for narrow streams, so it needs OutputManagerConsole.h.
+		 */
+		OutputManager(StringType&& Separator, StringType&& EndOfLine);
+		/**
+		 * @brief All parameters are initialised.
+		 * 
+		 * @note Alignment of text is defaulted to left. To change it use SetAlignment(int).
+		 */
+		OutputManager(OutType& OutStream, StringType&& Separator, StringType&& EndOfLine);
+
+
+
+		/**
+		 * @brief Prints the `EndOfLine__` attribute.
+		 */
+	    void operator()();
+		/** 
+		 * @brief Prints a single parameter of any type.
+		 *
+		 * @details Prints the `ToPrint` parameter, then `EndOfLine__`.
+		 * @warning The type `T` must be printable with `operator<<` or have an OutputFormatter specialisation.
+		 * @tparam T A printable type.
+		 * @see operator()(T&& ToPrint, P&&... ToPass)
+		 */
+	    template<typename T> void operator()(T&& ToPrint);
+		/** 
+		 * @brief Prints many parameters on a single line.
+		 * 
+		 * @details Prints the `ToPrint` parameter, then the `Separator__`, then all parameters in `ToPass` separated by `Separator__`, then `EndOfLine__`. If all parameters have a bounded length, such as numbers, the line is reserved once and written without further checks.
+		 * @warning The type `T` must be printable with `operator<<` or have an OutputFormatter specialisation.
+		 * @tparam T A printable type.
+		 * @tparam P A pack of printable types.
+		 * @see operator()(T&& ToPrint)
+		 */
+		template<typename T, typename... P> void operator()(T&& ToPrint, P&&... ToPass);
+
+		/**
+		 * @brief A scope printing many lines at the cost of one, see Batch(size_t).
+		 */
+		class LineBatch {
+			private:
+				OutputManager& Manager__;
+
+			public:
+				LineBatch(LineBatch const&) = delete;
+				LineBatch& operator=(LineBatch const&) = delete;
+
+				/**
+				 * @brief Takes a snapshot of the stream state and reserves `Reserve` characters.
+				 */
+				LineBatch(OutputManager& Manager, size_t Reserve);
+				/**
+				 * @brief Writes out the lines still buffered.
+				 */
+				~LineBatch();
+				/**
+				 * @brief Prints a line, like operator()(T&& ToPrint, P&&... ToPass), into the shared buffer.
+				 */
+				template<typename... T> void operator()(T const&... Elements);
+		};
+		/**
+		 * @brief Opens a scope that prints many lines with a single snapshot of the stream state and a single buffer.
+		 * 
+		 * @details Every call to operator()(T&& ToPrint, P&&... ToPass) reads the state of the stream and writes its line out before returning. The lines of a batch skip both: they are appended to a buffer reserved once, which is written out whenever it holds a block, see SetMemoryCap(size_t, int), and when the batch goes out of scope.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     std::vector<int> A(1000000, 1);
+		 *     std::vector<double> B(1000000, 2.5);
+		 *     OutputManager O;
+		 *     auto Lines = O.Batch();
+		 *     for (size_t i = 0; i < A.size(); ++i) {
+		 *         Lines(i, A[i], B[i]);
+		 *     }
+		 * }
+		 * ```
+		 * @param Reserve The number of characters to reserve up front.
+		 * @warning Changes to the stream formatting state, or other printers of the same OutputManager, must wait until the batch is destroyed.
+		 * @return The batch, which must not outlive the OutputManager.
+		 */
+		LineBatch Batch(size_t Reserve = BlockSize__);
+
+		/**
+		 * @brief Prints all elements in range.
+		 * 
+		 * @details Prints all elements in the range separated by the `Separator__` attribute, then prints `EndOfLine__`.
+		 * @warning No control is performed on the passed range.
+		 * @tparam It A  Forward interator.
+		 * @param Begin Begin of range to print.
+		 * @param End End of range to print.
+		 */
+		template<typename It> void PrintRange(It Begin, It End);
+		/**
+		 * @brief Prints in columns.
+		 *
+		 * @details Iterates over all given arguments and prints the data in columns, row by row.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include <string>
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     std::vector<int> Numbers {1, 2, 3, 4, 5};	
+		 *     std::vector<double> Floats {1.1, 2.1, 3.1, 4.1, 5.1};	
+		 *     std::vector<std::wstring> Words {L"Cat", L"Dog", L"Mouse", L"Cow", L"Salmon"};
+		 *     OutputManager O;
+		 *     O.FormatToColumns(Numbers.begin(), Numbers.end(), Floats.begin(), Words.begin());
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 1 1.1 Cat
+		 * 2 2.1 Dog
+		 * 3 3.1 Mouse
+		 * 4 4.1 Cow
+		 * 5 5.1 Salmon
+		 * ```
+		 * @tparam It A forward iterator.
+		 * @tparam Its A pack of forward iterators.
+		 * @param Begin Begin of the range to be printed in the first column.
+		 * @param End End of the range to be printed in the first column.
+		 * @param Others Begin of the other ranges, printed in order. The number of elements printed is the distance between `Begin` and `End`.
+		 * @warning No control is performed on the passed ranges, every iterator passed in `Others` must cover a range at least as long as the distance between `Begin` and `End`.
+		 */
+		template<typename It, typename... Its> void FormatToColumns(It Begin, It End, Its... Others);
+		/**
+		 * @brief Prints in rows.
+		 * 
+		 * @details Iterates over all given elements and prints the data in rows, range by range.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include <string>
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     std::vector<int> Numbers {1, 2, 3, 4, 5};	
+		 *     std::vector<double> Floats {1.1, 2.1, 3.1, 4.1, 5.1};	
+		 *     std::vector<std::wstring> Words {L"Cat", L"Dog", L"Mouse", L"Cow", L"Salmon"};
+		 *     OutputManager O;
+		 *     O.FormatToRows(Numbers.begin(), Numbers.end(), Floats.begin(), Words.begin());
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 1 2 3 4 5	
+		 * 1.1 2.1 3.1 4.1 5.1
+		 * Cat Dog Mouse Cow Salmon
+		 * ```
+		 * @tparam It A forward iterator.
+		 * @tparam Its A pack of forward iterators.
+		 * @param Begin Begin of the range to be printed in the first line.
+		 * @param End End of the range to be printed in the first line.
+		 * @param Others Begin of the other ranges, printed in order. The number of elements printed is the distance between `Begin` and `End`.
+		 * @warning No control is performed on the passed ranges, every iterator passed in `Others` must cover a range at least as long as the distance between `Begin` and `End`.
+		 */
+		template<typename It, typename... Its> void FormatToRows(It Begin, It End, Its... Others);
+		/**
+		 * @brief Prints in rows, formatting the rows in parallel.
+		 * 
+		 * @details Same output as FormatToRows(It, It, Its...), but every row is split into chunks which are formatted on a work-stealing pool into separate buffers and written to `OutStream__` in order as soon as all the previous ones are out. Long rows are split across several chunks, so uneven row lengths still balance across cores. The threads are set by SetWorkers(size_t), and the chunks waiting to be written are bounded by SetMemoryCap(size_t, int).
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include "OutputManagerConsole.h"
+		 * #include "OutputManagerParallel.h"
+		 * 
+		 * int main () {
+		 *     std::vector<double> Values(100000000, 1.5);
+		 *     OutputManager O;
+		 *     O.ParallelFormatToRows(Values.begin(), Values.end());
+		 * }
+		 * ```
+		 * @tparam It A forward iterator.
+		 * @tparam Its A pack of forward iterators.
+		 * @param Begin Begin of the range to be printed in the first line.
+		 * @param End End of the range to be printed in the first line.
+		 * @param Others Begin of the other ranges, printed in order. The number of elements printed is the distance between `Begin` and `End`.
+		 * @warning No control is performed on the passed ranges, every iterator passed in `Others` must cover a range at least as long as the distance between `Begin` and `End`.
+		 * @warning Elements are read and printed from several threads at once, their `operator<<` must be safe to call concurrently on distinct streams.
+		 * @warning Defined in OutputManagerParallel.h, which must be included to call it.
+		 */
+		template<typename It, typename... Its> void ParallelFormatToRows(It Begin, It End, Its... Others);
+		/**
+		 * @brief Prints a hexadecimal dump of a byte buffer, in the style of `xxd`.
+		 * 
+		 * @details Every line holds the offset of its first byte, the bytes in hexadecimal, grouped and separated by `Separator__`, and the bytes as ASCII, with `.` for non printable characters. The offset has at least 8 digits, or `Width__` if larger. Hexadecimal digits follow `std::uppercase`.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     const char Text[] = "Hello, World!\nSalmon";
+		 *     OutputManager O;
+		 *     O.HexDump(Text, sizeof(Text));
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 00000000: 4865 6c6c 6f2c 2057 6f72 6c64 210a 5361  Hello, World!.Sa
+		 * 00000010: 6c6d 6f6e 00                             lmon.
+		 * ```
+		 * @param Data The bytes to print.
+		 * @param Size The number of bytes to print.
+		 * @param BytesPerLine The number of bytes on each line.
+		 * @param Group The number of bytes in each group of hexadecimal digits, if `0` the bytes of a line are not split.
+		 */
+		void HexDump(const void* Data, size_t Size, size_t BytesPerLine = 16, size_t Group = 2);
+		/**
+		 * @brief Sets the number of threads used by the parallel printers.
+		 * @param Workers The number of threads, if `0` it defaults to `std::thread::hardware_concurrency()`.
+		 */
+		void SetWorkers(size_t Workers);
+		/**
+		 * @brief Limits the memory held by the internal buffers.
+		 * 
+		 * @details The formatting buffer is flushed before it outgrows `Bytes` and released if a single line made it larger. The parallel printers either stop formatting new chunks while the finished ones exceed `Bytes`, or write the excess to a temporary file which is read back in order. The cap is soft: a single element or line longer than `Bytes` is still buffered whole, and every worker may hold one chunk beyond it.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include "OutputManagerConsole.h"
+		 * #include "OutputManagerParallel.h"
+		 * 
+		 * int main () {
+		 *     std::vector<double> Values(100000000, 1.5);
+		 *     OutputManager O;
+		 *     O.SetMemoryCap(64 << 20, 1);
+		 *     O.ParallelFormatToRows(Values.begin(), Values.end());
+		 *     std::wcerr << O.PeakMemoryFootprint() << std::endl;
+		 * }
+		 * ```
+		 * @param Bytes The limit in bytes, if `0` there is no limit.
+		 * @param Overflow If positive the parallel printers spill to a temporary file, otherwise they wait for the output to drain.
+		 */
+		void SetMemoryCap(size_t Bytes, int Overflow = 0);
+		/**
+		 * @brief The number of bytes currently held by the internal buffers.
+		 * @details Safe to call from another thread while a parallel printer runs, once SetMemoryCap(size_t, int) or SetWorkers(size_t) was called before it started.
+		 */
+		size_t MemoryFootprint() const;
+		/**
+		 * @brief The largest number of bytes held by the internal buffers since construction, spilled chunks excluded.
+		 */
+		size_t PeakMemoryFootprint() const;
+		/**
+		 * @brief Prints only the first `N` elements of the given ranges in rows.
+		 * 
+		 * @details Iterates over all given elements and prints the first `N` elements of each range in rows, range by range.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include <string>
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     std::vector<int> Numbers {1, 2, 3, 4, 5};	
+		 *     std::vector<double> Floats {1.1, 2.1, 3.1, 4.1, 5.1};	
+		 *     std::vector<std::wstring> Words {L"Cat", L"Dog", L"Mouse", L"Cow", L"Salmon"};
+		 *     OutputManager O;
+		 *     O.FirstNElementsRows(3, Numbers.begin(), Floats.begin(), Words.begin());
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 1 2 3
+		 * 1.1 2.1 3.1	
+		 * Cat Dog Mouse
+		 * ```
+		 * @tparam N The number of rows to print from the first.
+		 * @tparam It A forward iterator.
+		 * @tparam Its A pack of forward iterators.
+		 * @param Begin Begin of the range to be printed in the first line.
+		 * @param Others Begin of the other ranges, printed in order.
+		 * @warning No control is performed on the passed ranges, every iterator passed must cover a range long at least N.
+		 */
+		template<typename It, typename... Its> void FirstNElementsRows(size_t N, It Begin, Its... Others);
+
+		/**
+		 * @brief Set the Width object
+		 * 
+		 * @details **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include <string>
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     std::vector<int> Numbers {1, 2, 3, 4, 5};	
+		 *     std::vector<double> Floats {1.1, 2.1, 3.1, 4.1, 5.1};	
+		 *     std::vector<std::wstring> Words {L"Cat", L"Dog", L"Mouse", L"Cow", L"Salmon"};
+		 *     OutputManager O;
+		 *     O.SetWidth(5);
+		 *     O.FormatToColumns(Numbers.begin(), Numbers.end(), Floats.begin(), Words.begin());
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 1     1.1     Cat  
+		 * 2     2.1     Dog  
+		 * 3     3.1     Mouse
+		 * 4     4.1     Cow  
+		 * 5     5.1     Salmon
+		 * ```
+		 * @param Width The minimum width (in characters) of each column of the output.
+		 * @note The printers reserve room for the padded elements before writing them, so a width larger than memory makes them throw `std::bad_alloc` without writing anything.
+		 */
+		void SetWidth(size_t Width);
+		/**
+		 * @brief Sets the `Separator__` attribute.
+		 * @param Separator The new separator string.
+		 */
+		void SetSeparator(StringType&& Separator);
+		/**
+		 * @brief Sets the `EndOfLine__` attribute.
+		 * @param EndOfLine The new end of line string.
+		 */
+		void SetEndOfLine(StringType&& EndOfLine);
+		/**
+		 * @brief Sets the alignment of text.
+		 * @param Alignment If the parameter is `0` the text is set to `std::internal`, if it's positive the text is set to `std::left`, if it's negative the text is set to `std::right`.
+		 */
+		void SetAlignment(int Alignment);
+		/**
+		 * @brief Sets the character used to pad text to `Width__`, which is also the fill character of the stream. Default is `' '`.
+		 * 
+		 * @details **Example:**
+		 * ```.cpp
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     OutputManager O;
+		 *     O.SetWidth(6);
+		 *     O.SetAlignment(-1);
+		 *     O.SetFill(L'0');
+		 *     O(42, 7);
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 000042 000007
+		 * ```
+		 * @param Fill The new fill character.
+		 */
+		void SetFill(typename OutType::char_type Fill);
+		/**
+		 * @brief Sets the output precision.
+		 * @param Precision The number of decimal places.
+		 */
+		void SetPrecision(size_t Precision);
+		/**
+		 * @brief Sets the float formatting flags.
+		 * 
+		 * @details Switches between `std::fixed`, `std::scientific` and default for the output mode of floating point decimals.
+		 * @param Mode If the parameter is `0` the floating point formatting is set to default, if it's positive the formatting is set to `std::fixed`, if it's negative it is set to `std::scientific`.
+		 */
+		void SetFloatMode (int Mode);
+		/**
+		 * @brief Sets the base integers are printed in.
+		 * 
+		 * @details Bases other than 10 print the bits of the value as unsigned, like `std::hex` and `std::oct` do, without any prefix. Hexadecimal digits follow `std::uppercase`. Character types and `bool` are not affected.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include <vector>
+		 * #include <cstdint>
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     std::vector<uint32_t> Masks {0x1F, 0xDEADBEEF};
+		 *     OutputManager O;
+		 *     O.SetBase(16, true);
+		 *     O.PrintRange(Masks.begin(), Masks.end());
+		 *     O.SetBase(2);
+		 *     O.PrintRange(Masks.begin(), Masks.begin() + 1);
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 0000001f deadbeef 
+		 * 11111 
+		 * ```
+		 * @param Base The base, one of `2`, `8`, `10` and `16`. Any other value is treated as `10`.
+		 * @param Pad If `true`, integers in base 2, 8 or 16 are padded with zeros to the width of their type.
+		 */
+		void SetBase(unsigned Base, bool Pad = false);
+		/**
+		 * @brief Groups the digits of the numbers in a column with a thousands separator.
+		 * 
+		 * @details Columns are counted by position on the line, from `0`: the arguments of operator()(), the ranges of FormatToColumns(It, It, Its...) and the elements of PrintRange(It, It). Only numbers in base 10 formatted by the built-in kernels are grouped, numbers printed with `operator<<` follow the locale of the stream instead. Other columns are not affected.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     OutputManager O;
+		 *     O.SetGrouping(1);
+		 *     O(1234567, 1234567, 1234567.5);
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 1234567 1,234,567 1.23457e+06
+		 * ```
+		 * @param Column The column to group.
+		 * @param Separator The thousands separator, `0` to stop grouping the column.
+		 */
+		void SetGrouping(size_t Column, typename OutType::char_type Separator = typename OutType::char_type(','));
+		/**
+		 * @brief Prints the numbers in a column as human readable sizes, like `12.3 MiB`.
+		 * 
+		 * @details Numbers are scaled by the unit base until they are smaller than it and printed with one decimal and the unit, up to exabytes. Numbers smaller than the base are followed by ` B`. Columns are counted as in SetGrouping(size_t, typename OutType::char_type), which can be combined with units. Other columns are not affected.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     OutputManager O;
+		 *     O.SetUnits(0, 1);
+		 *     O.SetUnits(1, -1);
+		 *     O(12900000, 12900000, 512);
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 12.3 MiB 12.9 MB 512
+		 * ```
+		 * @param Column The column to print as sizes.
+		 * @param Units If positive IEC units (`KiB`, `MiB`, ...) in powers of 1024, if negative SI units (`kB`, `MB`, ...) in powers of 1000, if `0` plain numbers.
+		 */
+		void SetUnits(size_t Column, int Units);
+		/**
+		 * @brief Puts the current time before every non empty line, followed by the separator.
+		 * 
+		 * @details The part up to the second is formatted with `std::strftime` in local time, and only again when the second changes, the fraction of a second is written for every line. Every printer stamps its lines: operator()(T&&, P&&...), PrintRange(It, It), FormatToColumns(It, It, Its...), FormatToRows(It, It, Its...), ParallelFormatToRows(It, It, Its...), HexDump(const void*, size_t, size_t, size_t) and a LineBatch. The timestamp is not a column: columns are still counted from the first element.
+		 * 
+		 * **Example:**
+		 * ```.cpp
+		 * #include "OutputManagerConsole.h"
+		 * 
+		 * int main () {
+		 *     OutputManager O;
+		 *     O.SetTimestamp("%H:%M:%S", 3);
+		 *     O(L"Started");
+		 * }
+		 * ```
+		 * **Output:**
+		 * ```
+		 * 14:03:27.512 Started
+		 * ```
+		 * @param Format The `std::strftime` format of the part up to the second, at most 63 characters once formatted. If empty lines are not stamped.
+		 * @param Digits The number of digits of the fraction of a second, up to 9. If `0` the fraction is left out.
+		 * @param Coarse `true` to read `CLOCK_REALTIME_COARSE` where available, which is cheaper but only advances every few milliseconds.
+		 * @warning The time is read when a line is formatted: the rows of ParallelFormatToRows(It, It, Its...) are stamped by the worker formatting them, so their times need not increase down the output, lines logged with DeferredLog are stamped when the background thread renders them, a few milliseconds after they were logged, and lines of a binary log when DeferredLogDecoder decodes them.
+		 */
+		void SetTimestamp(std::string const& Format = "%Y-%m-%d %H:%M:%S", unsigned Digits = 6, bool Coarse = false);
+};
+
+//
+//CONSTRUCTORS
+//
+template<typename OutType, typename StringType>
+OutputManager<OutType, StringType> ::OutputManager(OutType& OutStream) : OutStream__{OutStream} {
+	SetAlignment(1);
+}
+
+template<typename OutType, typename StringType>
+OutputManager<OutType, StringType> ::OutputManager(OutType& OutStream, StringType&& Separator, StringType&& EndOfLine) : Separators__{std::move(Separator), std::move(EndOfLine)}, OutStream__{OutStream} {
+	SetAlignment(1);
+}
+
+//
+//OPERATORS
+//
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::operator()() {
+	Append__(EndOfLine__);
+	Flush__();
+}
+
+template<typename OutType, typename StringType>
+template<typename T>
+void OutputManager<OutType, StringType> ::operator()(T&& ToPrint) {
+	PrintLine__(ToPrint);
+}
+
+template<typename OutType, typename StringType>
+template<typename T, typename...P>
+void OutputManager<OutType, StringType> ::operator()(T&& ToPrint, P&&... ToPass) {
+	PrintLine__(ToPrint, ToPass...);
+}
+
+//
+//BATCHES
+//
+template<typename OutType, typename StringType>
+typename OutputManager<OutType, StringType>::LineBatch OutputManager<OutType, StringType> ::Batch(size_t Reserve) {
+	return LineBatch(*this, Reserve);
+}
+
+template<typename OutType, typename StringType>
+OutputManager<OutType, StringType>::LineBatch ::LineBatch(OutputManager& Manager, size_t Reserve) : Manager__{Manager} {
+	Manager__.Refresh__();
+	Manager__.Buffer__.Reserve(std::min(Reserve, Manager__.BlockLength__(1)));
+}
+
+template<typename OutType, typename StringType>
+OutputManager<OutType, StringType>::LineBatch ::~LineBatch() {
+	Manager__.Flush__();
+}
+
+template<typename OutType, typename StringType>
+template<typename... T>
+void OutputManager<OutType, StringType>::LineBatch ::operator()(T const&... Elements) {
+	Manager__.AppendLine__(Elements...);
+	if (Manager__.Buffer__.Size() >= Manager__.BlockLength__(1)) {
+		Manager__.Flush__();
+	}
+}
+
+//
+//FORMATTERS
+//
+template<typename OutType, typename StringType>
+template<typename It>
+void OutputManager<OutType, StringType> ::PrintRange(It Begin, It End) {
+	Refresh__();
+	if (Begin != End) {
+		StartLine__();
+	}
+	PrintElements__(Begin, End);
+	Append__(EndOfLine__);
+	Flush__();
+}
+
+template<typename OutType, typename StringType>
+template<typename It, typename... Its>
+void OutputManager<OutType, StringType> ::FormatToColumns(It Begin, It End, Its... Others) {
+	Refresh__();
+	if (const size_t Length = LineLength__<std::decay_t<decltype(*Begin)>, std::decay_t<decltype(*Others)>...>()) {
+		//Every column is bounded, so each block of rows is reserved once and written unchecked.
+		const size_t Block = BlockLength__(Length);
+		while (Begin != End) {
+			size_t Rows = Block;
+			if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>) {
+				Rows = std::min<size_t>(Rows, End - Begin);
+			}
+			if (Timestamp__()) {
+				//The timestamp is appended to the buffer, so every row is reserved on its own after it.
+				for (size_t i = 0; i < Rows && Begin != End; ++i, ++Begin) {
+					AppendLine__(*Begin, *Others...);
+					([](auto& Iterator){
+						std::advance(Iterator, 1);
+					}(Others),...);
+				}
+			}
+			else {
+				Char__* Out = Buffer__.Reserve(Rows * Length);
+				for (size_t i = 0; i < Rows && Begin != End; ++i, ++Begin) {
+					Out = WriteLine__(Out, *Begin, *Others...);
+					([](auto& Iterator){
+						std::advance(Iterator, 1);
+					}(Others),...);
+				}
+				Buffer__.Commit(Out);
+			}
+			Flush__();
+		}
+		return;
+	}
+	for (;Begin != End; ++Begin) {
+		operator()(*Begin, *std::forward<Its>(Others)...);
+		//https://www.fluentcpp.com/2019/03/05/for_each_arg-applying-a-function-to-each-argument-of-a-function-in-cpp/
+		([](auto&& Iterator){
+			std::advance(Iterator, 1);
+		}(std::forward<Its>(Others)),...);
+	}
+	return;
+}
+
+template<typename OutType, typename StringType>
+template<typename It, typename... Its>
+void OutputManager<OutType, StringType> ::FormatToRows(It Begin, It End, Its... Others) {
+	PrintRange(Begin, End);
+	([&](auto&& NewBegin){
+		auto NewEnd = NewBegin;
+		std::advance(NewEnd, std::distance(Begin, End));
+		PrintRange(NewBegin, NewEnd);
+	}(std::forward<Its>(Others)),...);
+	return;
+}
+
+template<typename OutType, typename StringType>
+template<typename It, typename... Its>
+void OutputManager<OutType, StringType> ::ParallelFormatToRows(It Begin, It End, Its... Others) {
+	//ParallelRows depends on It, so without OutputManagerParallel.h this does not compile, instead of failing to link.
+	OutputManagerDetail::ParallelRows<It>::Print(*this, Begin, End, Others...);
+}
+
+template<typename OutType, typename StringType>
+template<typename It, typename... Its>
+void OutputManager<OutType, StringType> ::FirstNElementsRows(size_t N, It Begin, Its... Others) {
+	auto End = Begin;
+	std::advance (End, N);
+	FormatToRows(Begin, End, Others...);
+	return;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::HexDump(const void* Data, size_t Size, size_t BytesPerLine, size_t Group) {
+	Refresh__();
+	const unsigned char* Bytes = static_cast<const unsigned char*>(Data);
+	BytesPerLine = std::max<size_t>(1, BytesPerLine);
+	Group = Group ? Group : BytesPerLine;
+	size_t OffsetDigits = 1;
+	for (size_t Rest = Size ? (Size - 1) >> 4 : 0; Rest; Rest >>= 4) {
+		++OffsetDigits;
+	}
+	OffsetDigits = std::max({OffsetDigits, size_t(8), Width__});
+	const size_t Groups = (BytesPerLine + Group - 1) / Group;
+	const size_t LineLength = OutputManagerDetail::AddSaturated(OffsetDigits, 1 + 3 * Separator__.size() + 3 * BytesPerLine + (Groups - 1) * Separator__.size() + EndOfLine__.size());
+	const size_t Block = BlockLength__(LineLength);
+	const char* Pairs = State__.Upper ? OutputManagerDetail::UpperHexPairs : OutputManagerDetail::HexPairs;
+	//The bytes of a whole block of lines are contiguous, so they are turned into digits at once, which lets the wide kernels run.
+	OutputManagerDetail::OutputBuffer<char> Scratch;
+	char* Hex = Scratch.Reserve(2 * std::min(Block * BytesPerLine, Size));
+	size_t Offset = 0;
+	while (Offset < Size) {
+		const size_t Lines = std::min(Block, (Size - Offset + BytesPerLine - 1) / BytesPerLine);
+		OutputManagerDetail::HexBytes(Hex, Bytes + Offset, std::min(Lines * BytesPerLine, Size - Offset), State__.Upper);
+		const char* Digits = Hex;
+		Char__* Out = Buffer__.Reserve(Lines * LineLength);
+		for (size_t Line = 0; Line < Lines; ++Line) {
+			if (Timestamp__()) {
+				//The timestamp is appended to the buffer, so every line is reserved on its own after it.
+				Buffer__.Commit(Out);
+				StartLine__();
+				Out = Buffer__.Reserve(LineLength);
+			}
+			const size_t Count = std::min(BytesPerLine, Size - Offset);
+			size_t Rest = Offset;
+			for (size_t i = OffsetDigits; i; --i, Rest >>= 4) {
+				Out[i - 1] = Char__(Pairs[2 * (Rest & 0xF) + 1]);
+			}
+			Out += OffsetDigits;
+			*Out++ = Char__(':');
+			Out = Copy__(Out, Separator__);
+			for (size_t First = 0; First < BytesPerLine; First += Group) {
+				const size_t Length = std::min(Group, BytesPerLine - First);
+				const size_t Shown = First < Count ? std::min(Length, Count - First) : 0;
+				if (First) {
+					//Short last lines are padded with spaces, so the ASCII column stays aligned.
+					Out = Shown ? Copy__(Out, Separator__) : std::fill_n(Out, Separator__.size(), Char__(' '));
+				}
+				Out = std::copy_n(Digits + 2 * First, 2 * Shown, Out);
+				Out = std::fill_n(Out, 2 * (Length - Shown), Char__(' '));
+			}
+			Out = Copy__(Copy__(Out, Separator__), Separator__);
+			for (size_t i = 0; i < Count; ++i) {
+				const unsigned char Byte = Bytes[Offset + i];
+				*Out++ = Byte >= 0x20 && Byte < 0x7F ? Char__(Byte) : Char__('.');
+			}
+			Out = Copy__(Out, EndOfLine__);
+			Offset += Count;
+			Digits += 2 * Count;
+		}
+		Buffer__.Commit(Out);
+		Flush__();
+	}
+}
+
+//
+//HELPERS
+//
+template<typename OutType, typename StringType>
+template<typename It>
+void OutputManager<OutType, StringType> ::PrintElements__(It Begin, It End, size_t Column) {
+	//Columns with their own format go one by one, the rest can be reserved in blocks.
+	for (const size_t Formatted = Extras__ ? Extras__->Columns.Size() : 0; Begin != End && Column < Formatted; ++Begin, ++Column) {
+		Put__(*Begin, Column);
+		Append__(Separator__);
+	}
+	if (const size_t Length = MaxLength__<std::decay_t<decltype(*Begin)>>(Column)) {
+		//Every element is bounded, so each block of elements is reserved once and written unchecked.
+		const size_t Step = OutputManagerDetail::AddSaturated(std::max(Width__, Length), Separator__.size());
+		const size_t Block = BlockLength__(Step);
+		while (Begin != End) {
+			size_t Count = Block;
+			if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>) {
+				Count = std::min<size_t>(Count, End - Begin);
+			}
+			Char__* Out = Buffer__.Reserve(Count * Step);
+			for (size_t i = 0; i < Count && Begin != End; ++i, ++Begin) {
+				Out = Copy__(Write__(Out, *Begin, Column), Separator__);
+			}
+			Buffer__.Commit(Out);
+			if (Begin != End) {
+				Flush__();
+			}
+		}
+		return;
+	}
+	for (;Begin != End; ++Begin, ++Column) {
+		Put__(*Begin, Column);
+		Append__(Separator__);
+		Drain__();
+	}
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::Refresh__() {
+	const std::ios_base::fmtflags Flags = OutStream__.flags();
+	const std::ios_base::fmtflags Base = Flags & std::ios_base::basefield;
+	const std::ios_base::fmtflags Float = Flags & std::ios_base::floatfield;
+	const std::streamsize Precision = OutStream__.precision();
+	State__.Numeric = !(Flags & (std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::showbase | std::ios_base::uppercase))
+		&& (!Base || Base == std::ios_base::dec)
+		&& Float != (std::ios_base::fixed | std::ios_base::scientific)
+		&& Precision >= 0 && Precision <= MaxFloatPrecision__
+		&& OutStream__.getloc() == std::locale::classic();
+	State__.Upper = Flags & std::ios_base::uppercase;
+	State__.Adjust = Flags & std::ios_base::adjustfield;
+	State__.Fill = OutStream__.fill();
+	State__.FloatFormat = Float == std::ios_base::fixed ? std::chars_format::fixed : Float == std::ios_base::scientific ? std::chars_format::scientific : std::chars_format::general;
+	State__.Precision = static_cast<int>(Precision);
+}
+
+template<typename OutType, typename StringType>
+typename OutputManager<OutType, StringType>::Char__* OutputManager<OutType, StringType> ::Widen__(const char* Begin, const char* End, Char__* Out) const {
+	for (; Begin != End; ++Begin) {
+		*Out++ = OutStream__.widen(*Begin);
+	}
+	return Out;
+}
+
+template<typename OutType, typename StringType>
+typename OutputManager<OutType, StringType>::ColumnFormat__ const* OutputManager<OutType, StringType> ::Format__(size_t Column) const {
+	return Extras__ && Column < Extras__->Columns.Size() ? Extras__->Columns.Data() + Column : nullptr;
+}
+
+template<typename OutType, typename StringType>
+typename OutputManager<OutType, StringType>::Char__* OutputManager<OutType, StringType> ::Group__(Char__* Begin, Char__* End, ColumnFormat__ const* Format) const {
+	if (Format && Format->Grouping) {
+		return OutputManagerDetail::GroupThousands(Begin, End, Format->Grouping);
+	}
+	return End;
+}
+
+template<typename OutType, typename StringType>
+template<typename T>
+size_t OutputManager<OutType, StringType> ::MaxLength__(size_t Column) const {
+	ColumnFormat__ const* Format = Format__(Column);
+	if constexpr (OutputManagerDetail::HasOutputFormatter<T, Char__>) {
+		if constexpr (OutputManagerDetail::HasMaxLength<T>::value) {
+			return OutputFormatter<T>::max_length;
+		}
+		else {
+			return 0;
+		}
+	}
+	else if constexpr (OutputManagerDetail::IsNumericInteger<T>) {
+		if (Format && Format->Units) {
+			//See FormatUnits().
+			return 24;
+		}
+		if (Base__ != 10) {
+			return OutputManagerDetail::BaseDigits<T>(Base__ == 16 ? 4 : Base__ == 8 ? 3 : 1);
+		}
+		const size_t Grouping = Format && Format->Grouping ? (std::numeric_limits<T>::digits10 + 1) / 3 : 0;
+		return State__.Numeric ? std::numeric_limits<T>::digits10 + 2 + Grouping : 0;
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		//Fixed notation grows with the exponent, so it has no useful bound, and so do sizes.
+		if (!State__.Numeric || State__.FloatFormat == std::chars_format::fixed || (Format && Format->Units)) {
+			return 0;
+		}
+		//Sign, point and an exponent of up to four digits, or the leading "0.000" of general notation.
+		const size_t Digits = std::max(State__.Precision, 1);
+		return Digits + 10 + (Format && Format->Grouping ? Digits / 3 : 0);
+	}
+	else {
+		return 0;
+	}
+}
+
+template<typename OutType, typename StringType>
+template<typename... T>
+size_t OutputManager<OutType, StringType> ::LineLength__() const {
+	size_t Column = 0;
+	const size_t Lengths[] = {MaxLength__<T>(Column++)...};
+	size_t Total = (sizeof...(T) - 1) * Separator__.size() + EndOfLine__.size();
+	for (const size_t Length : Lengths) {
+		if (!Length) {
+			return 0;
+		}
+		Total = OutputManagerDetail::AddSaturated(Total, std::max(Width__, Length));
+	}
+	return Total;
+}
+
+template<typename OutType, typename StringType>
+template<typename T>
+typename OutputManager<OutType, StringType>::Char__* OutputManager<OutType, StringType> ::Write__(Char__* Out, T const& Element, size_t Column) {
+	if constexpr (OutputManagerDetail::HasOutputFormatter<T, Char__>) {
+		if constexpr (OutputManagerDetail::FormatsTo<T, Char__>::value) {
+			return Pad__(Out, OutputFormatter<T>::format_to(Out, Element), false);
+		}
+		else if constexpr (OutputManagerDetail::HasMaxLength<T>::value) {
+			char Narrow[OutputFormatter<T>::max_length + 1];
+			const char* NarrowEnd = OutputFormatter<T>::format_to(Narrow, Element);
+			return Pad__(Out, Widen__(Narrow, NarrowEnd, Out), false);
+		}
+		else {
+			return Out;
+		}
+	}
+	else if constexpr (OutputManagerDetail::IsNumericInteger<T>) {
+		ColumnFormat__ const* Format = Format__(Column);
+		if (Format && Format->Units) {
+			char Narrow[24];
+			return Pad__(Out, Group__(Out, std::copy(Narrow, OutputManagerDetail::FormatUnits(Narrow, Element, Format->Units), Out), Format), true);
+		}
+		if (Base__ != 10) {
+			return Pad__(Out, OutputManagerDetail::FormatBase(Out, Element, Base__, BasePad__, State__.Upper), true);
+		}
+		return Pad__(Out, Group__(Out, OutputManagerDetail::FormatDecimal(Out, Element), Format), true);
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		char Narrow[MaxFloatPrecision__ + 16];
+		const auto Result = std::to_chars(Narrow, std::end(Narrow), Element, State__.FloatFormat, State__.Precision);
+		return Pad__(Out, Group__(Out, std::copy(Narrow, Result.ptr, Out), Format__(Column)), true);
+	}
+	else {
+		//Unbounded types never get here, see MaxLength__().
+		return Out;
+	}
+}
+
+template<typename OutType, typename StringType>
+template<typename T, typename... P>
+typename OutputManager<OutType, StringType>::Char__* OutputManager<OutType, StringType> ::WriteLine__(Char__* Out, T const& First, P const&... Rest) {
+	size_t Column = 0;
+	Out = Write__(Out, First, Column++);
+	((Out = Write__(Copy__(Out, Separator__), Rest, Column++)),...);
+	return Copy__(Out, EndOfLine__);
+}
+
+template<typename OutType, typename StringType>
+template<typename Text>
+typename OutputManager<OutType, StringType>::Char__* OutputManager<OutType, StringType> ::Copy__(Char__* Out, Text const& Value) const {
+	return std::copy(Value.data(), Value.data() + Value.size(), Out);
+}
+
+template<typename OutType, typename StringType>
+typename OutputManager<OutType, StringType>::Char__* OutputManager<OutType, StringType> ::Pad__(Char__* Begin, Char__* End, bool Numeric) const {
+	const size_t Length = End - Begin;
+	if (Length >= Width__) {
+		return End;
+	}
+	const size_t Padding = Width__ - Length;
+	if (State__.Adjust == std::ios_base::left) {
+		return Fill__(End, Padding);
+	}
+	Char__* Split = Begin;
+	if (Numeric && State__.Adjust == std::ios_base::internal && Length && (*Begin == Char__('-') || *Begin == Char__('+'))) {
+		++Split;
+	}
+	std::memmove(Split + Padding, Split, (End - Split) * sizeof(Char__));
+	Fill__(Split, Padding);
+	return End + Padding;
+}
+
+template<typename OutType, typename StringType>
+typename OutputManager<OutType, StringType>::Char__* OutputManager<OutType, StringType> ::Fill__(Char__* Out, size_t Count) const {
+	if constexpr (sizeof(Char__) == 1) {
+		std::memset(Out, static_cast<unsigned char>(State__.Fill), Count);
+		return Out + Count;
+	}
+	else if constexpr (std::is_same_v<Char__, wchar_t>) {
+		std::wmemset(Out, State__.Fill, Count);
+		return Out + Count;
+	}
+	else {
+		return std::fill_n(Out, Count, State__.Fill);
+	}
+}
+
+template<typename OutType, typename StringType>
+template<typename T>
+void OutputManager<OutType, StringType> ::Put__(T const& Element, size_t Column) {
+	if constexpr (OutputManagerDetail::HasOutputFormatter<T, Char__>) {
+		const size_t Hint = OutputFormatter<T>::size_hint(Element);
+		Char__* Out = Buffer__.Reserve(std::max(Width__, Hint));
+		Char__* End = Out;
+		if constexpr (OutputManagerDetail::FormatsTo<T, Char__>::value) {
+			End = OutputFormatter<T>::format_to(Out, Element);
+		}
+		else {
+			//Formats to a narrow scratch buffer, then widens with the stream locale.
+			OutputManagerDetail::OutputBuffer<char> Scratch;
+			char* Narrow = Scratch.Reserve(Hint + 1);
+			const char* NarrowEnd = OutputFormatter<T>::format_to(Narrow, Element);
+			End = Widen__(Narrow, NarrowEnd, Out);
+		}
+		Buffer__.Commit(Pad__(Out, End, false));
+	}
+	else if constexpr (OutputManagerDetail::IsString<T, Char__>::value) {
+		if constexpr (std::is_pointer_v<T>) {
+			if (!Element) {
+				Flush__();
+				OutStream__.width(Width__);
+				OutStream__ << Element;
+				return;
+			}
+		}
+		const std::basic_string_view<Char__> Text(Element);
+		Char__* Out = Buffer__.Reserve(std::max(Width__, Text.size()));
+		Buffer__.Commit(Pad__(Out, std::copy(Text.begin(), Text.end(), Out), false));
+	}
+	else {
+		if constexpr (OutputManagerDetail::IsNumericInteger<T> || std::is_floating_point_v<T>) {
+			if (const size_t Length = MaxLength__<T>(Column)) {
+				Buffer__.Commit(Write__(Buffer__.Reserve(std::max(Width__, Length)), Element, Column));
+				return;
+			}
+		}
+		if constexpr (std::is_floating_point_v<T>) {
+			ColumnFormat__ const* Format = Format__(Column);
+			if (Format && Format->Units) {
+				char Narrow[400];
+				char* NarrowEnd = OutputManagerDetail::FormatUnits(Narrow, Element, Format->Units);
+				const size_t Length = NarrowEnd - Narrow;
+				Char__* Out = Buffer__.Reserve(std::max(Width__, Length + Length / 3));
+				Buffer__.Commit(Pad__(Out, Group__(Out, std::copy(Narrow, NarrowEnd, Out), Format), true));
+				return;
+			}
+		}
+		if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+			if (State__.Numeric && State__.FloatFormat == std::chars_format::fixed && State__.Precision <= OutputManagerDetail::MaxFixedPrecision) {
+				//Sign, sixteen integer digits with their separators and point, see FormatFixed().
+				Char__* Out = Buffer__.Reserve(std::max<size_t>(Width__, State__.Precision + 24));
+				if (Char__* End = OutputManagerDetail::FormatFixed(Out, Element, State__.Precision)) {
+					Buffer__.Commit(Pad__(Out, Group__(Out, End, Format__(Column)), true));
+					return;
+				}
+			}
+		}
+		if constexpr (std::is_floating_point_v<T>) {
+			if (State__.Numeric) {
+				//Fixed notation has no useful bound, so it is formatted aside and then copied.
+				char Narrow[512];
+				const auto Result = std::to_chars(Narrow, std::end(Narrow), Element, State__.FloatFormat, State__.Precision);
+				if (Result.ec == std::errc()) {
+					const size_t Length = Result.ptr - Narrow;
+					Char__* Out = Buffer__.Reserve(std::max(Width__, Length + Length / 3));
+					Buffer__.Commit(Pad__(Out, Group__(Out, std::copy(Narrow, Result.ptr, Out), Format__(Column)), true));
+					return;
+				}
+			}
+		}
+		Flush__();
+		OutStream__.width(Width__);
+		OutStream__ << Element;
+		//Manipulators, and any operator<< of a user type, may change the state the following elements are printed with.
+		Refresh__();
+	}
+}
+
+template<typename OutType, typename StringType>
+template<typename... T>
+void OutputManager<OutType, StringType> ::PrintLine__(T const&... Elements) {
+	Refresh__();
+	AppendLine__(Elements...);
+	Flush__();
+}
+
+template<typename OutType, typename StringType>
+template<typename... T>
+void OutputManager<OutType, StringType> ::AppendLine__(T const&... Elements) {
+	if constexpr (sizeof...(T) == 0) {
+		Append__(EndOfLine__);
+	}
+	else {
+		StartLine__();
+		if (const size_t Length = LineLength__<T...>()) {
+			Buffer__.Commit(WriteLine__(Buffer__.Reserve(Length), Elements...));
+		}
+		else {
+			size_t Column = 0;
+			((Column ? Append__(Separator__) : void(), Put__(Elements, Column++), Drain__()),...);
+			Append__(EndOfLine__);
+		}
+	}
+}
+
+template<typename OutType, typename StringType>
+template<typename Text>
+void OutputManager<OutType, StringType> ::Append__(Text const& Value) {
+	Buffer__.Append(Value.data(), Value.size());
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::AppendTimestamp__() {
+	OutputManagerDetail::Timestamp<Char__>& Stamp = *Timestamp__();
+	std::timespec Now;
+#if defined(CLOCK_REALTIME_COARSE)
+	clock_gettime(Stamp.Coarse ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME, &Now);
+#else
+	std::timespec_get(&Now, TIME_UTC);
+#endif
+	if (Now.tv_sec != Stamp.Second) {
+		std::tm Parts;
+#if defined(_WIN32)
+		localtime_s(&Parts, &Now.tv_sec);
+#else
+		localtime_r(&Now.tv_sec, &Parts);
+#endif
+		char Narrow[sizeof(Stamp.Text) / sizeof(Char__)];
+		Stamp.Length = std::strftime(Narrow, sizeof(Narrow), Stamp.Format.c_str(), &Parts);
+		Widen__(Narrow, Narrow + Stamp.Length, Stamp.Text);
+		Stamp.Second = Now.tv_sec;
+	}
+	Char__* Out = Buffer__.Reserve(Stamp.Length + 1 + Stamp.Digits);
+	Out = std::copy(Stamp.Text, Stamp.Text + Stamp.Length, Out);
+	if (Stamp.Digits) {
+		*Out++ = Char__('.');
+		long Fraction = Now.tv_nsec;
+		for (unsigned Digit = Stamp.Digits; Digit < 9; ++Digit) {
+			Fraction /= 10;
+		}
+		for (unsigned Digit = Stamp.Digits; Digit--;) {
+			Out[Digit] = Char__('0' + Fraction % 10);
+			Fraction /= 10;
+		}
+		Out += Stamp.Digits;
+	}
+	Buffer__.Commit(Out);
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::StartLine__() {
+	if (Timestamp__()) {
+		AppendTimestamp__();
+		Append__(Separator__);
+	}
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::Flush__() {
+	OutputManagerDetail::Limits const* Limits = Limits__();
+	if (Buffer__.Size()) {
+		if (Limits) {
+			Track__(Buffer__.Capacity() * sizeof(Char__) + Limits->Pending);
+		}
+		OutStream__.write(Buffer__.Data(), Buffer__.Size());
+		Buffer__.Clear();
+	}
+	if (Limits && Limits->MemoryCap && Buffer__.Capacity() * sizeof(Char__) > Limits->MemoryCap) {
+		Buffer__.Release();
+	}
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::Drain__() {
+	OutputManagerDetail::Limits const* Limits = Limits__();
+	if (Limits && Limits->MemoryCap && Buffer__.Size() * sizeof(Char__) >= Limits->MemoryCap) {
+		Flush__();
+	}
+}
+
+template<typename OutType, typename StringType>
+size_t OutputManager<OutType, StringType> ::BlockLength__(size_t Length) const {
+	OutputManagerDetail::Limits const* Limits = Limits__();
+	const size_t Limit = Limits && Limits->MemoryCap ? std::min(BlockSize__, Limits->MemoryCap / sizeof(Char__)) : BlockSize__;
+	return std::max<size_t>(1, Limit / Length);
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::Track__(size_t Bytes) {
+	std::atomic<size_t>& Highest = Limits__()->Peak;
+	size_t Peak = Highest.load(std::memory_order_relaxed);
+	while (Peak < Bytes && !Highest.compare_exchange_weak(Peak, Bytes, std::memory_order_relaxed)) {
+	}
+}
+
+template<typename OutType, typename StringType>
+OutputManagerDetail::Extras<typename OutType::char_type>& OutputManager<OutType, StringType> ::Extend__() {
+	if (!Extras__) {
+		Extras__.reset(new OutputManagerDetail::Extras<Char__>);
+	}
+	return *Extras__;
+}
+
+template<typename OutType, typename StringType>
+OutputManagerDetail::Timestamp<typename OutType::char_type>* OutputManager<OutType, StringType> ::Timestamp__() const {
+	return Extras__ ? Extras__->Timestamp.get() : nullptr;
+}
+
+template<typename OutType, typename StringType>
+OutputManagerDetail::Limits* OutputManager<OutType, StringType> ::Limits__() const {
+	return Extras__ ? Extras__->Limits.get() : nullptr;
+}
+
+template<typename OutType, typename StringType>
+OutputManagerDetail::Limits& OutputManager<OutType, StringType> ::MakeLimits__() {
+	OutputManagerDetail::Extras<Char__>& Extras = Extend__();
+	if (!Extras.Limits) {
+		Extras.Limits.reset(new OutputManagerDetail::Limits);
+	}
+	return *Extras.Limits;
+}
+
+template<typename OutType, typename StringType>
+template<typename Other>
+void OutputManager<OutType, StringType> ::CopySettingsTo__(Other& Target) const {
+	Target.OutStream__.copyfmt(OutStream__);
+	if constexpr (!Separators__::Static) {
+		Target.Separator__ = Separator__;
+		Target.EndOfLine__ = EndOfLine__;
+	}
+	Target.Width__ = Width__;
+	Target.Base__ = Base__;
+	Target.BasePad__ = BasePad__;
+	//A target without extras stays without them if there are none to copy, so printers made per chunk allocate nothing.
+	if (Extras__ || Target.Extras__) {
+		auto& Extras = Target.Extend__();
+		Extras.Columns.Clear();
+		Extras.Timestamp.reset();
+		if (Extras__) {
+			Extras.Columns.Append(Extras__->Columns.Data(), Extras__->Columns.Size());
+			if (Extras__->Timestamp) {
+				Extras.Timestamp.reset(new OutputManagerDetail::Timestamp<Char__>(*Extras__->Timestamp));
+			}
+		}
+	}
+	if (OutputManagerDetail::Limits const* Limits = Limits__()) {
+		OutputManagerDetail::Limits& Copy = Target.MakeLimits__();
+		Copy.Workers = Limits->Workers;
+		Copy.MemoryCap = Limits->MemoryCap;
+		Copy.Overflow = Limits->Overflow;
+	}
+}
+
+//
+//SETTERS
+//
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetWidth(size_t Width) {
+	Width__ = Width;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetWorkers(size_t Workers) {
+	MakeLimits__().Workers = Workers;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetMemoryCap(size_t Bytes, int Overflow) {
+	OutputManagerDetail::Limits& Limits = MakeLimits__();
+	Limits.MemoryCap = Bytes;
+	Limits.Overflow = Overflow;
+}
+
+template<typename OutType, typename StringType>
+size_t OutputManager<OutType, StringType> ::MemoryFootprint() const {
+	OutputManagerDetail::Limits const* Limits = Limits__();
+	return Buffer__.Capacity() * sizeof(Char__) + (Limits ? Limits->Pending.load() : 0);
+}
+
+template<typename OutType, typename StringType>
+size_t OutputManager<OutType, StringType> ::PeakMemoryFootprint() const {
+	//Without limits the buffer is never released, so its capacity is also its peak.
+	OutputManagerDetail::Limits const* Limits = Limits__();
+	return std::max(Limits ? Limits->Peak.load() : 0, MemoryFootprint());
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetFill(typename OutType::char_type Fill) {
+	OutStream__.fill(Fill);
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetSeparator(StringType&& Separator) {
+	static_assert(!Separators__::Static, "OutputManager: static separators cannot be changed");
+	Separator__ = Separator;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetEndOfLine(StringType&& EndOfLine) {
+	static_assert(!Separators__::Static, "OutputManager: static separators cannot be changed");
+	EndOfLine__ = EndOfLine;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetAlignment(int Alignment) {
+	if (Alignment)
+		if (Alignment > 0) {
+			 OutStream__ << std::left;
+		}
+		else {
+			OutStream__ << std::right;
+		}
+	else {
+		OutStream__ << std::internal;
+	}
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetPrecision(size_t Precision) {
+	OutStream__.precision(Precision);
+}
+
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetFloatMode(int Mode) {
+	if (Mode)
+		if (Mode > 0) {
+			 OutStream__ << std::fixed;
+		}
+		else {
+			OutStream__ << std::scientific;
+		}
+	else {
+		OutStream__.unsetf(std::ios_base::fixed);
+		OutStream__.unsetf(std::ios_base::scientific);
+	}
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetBase(unsigned Base, bool Pad) {
+	Base__ = static_cast<unsigned char>((Base == 2 || Base == 8 || Base == 16) ? Base : 10);
+	BasePad__ = Pad;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetGrouping(size_t Column, typename OutType::char_type Separator) {
+	auto& Columns = Extend__().Columns;
+	if (Columns.Size() <= Column) {
+		Columns.Append(Column + 1 - Columns.Size(), ColumnFormat__{});
+	}
+	Columns.Data()[Column].Grouping = Separator;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetUnits(size_t Column, int Units) {
+	auto& Columns = Extend__().Columns;
+	if (Columns.Size() <= Column) {
+		Columns.Append(Column + 1 - Columns.Size(), ColumnFormat__{});
+	}
+	Columns.Data()[Column].Units = Units;
+}
+
+template<typename OutType, typename StringType>
+void OutputManager<OutType, StringType> ::SetTimestamp(std::string const& Format, unsigned Digits, bool Coarse) {
+	if (Format.empty()) {
+		if (Extras__) {
+			Extras__->Timestamp.reset();
+		}
+		return;
+	}
+	auto& Stamp = Extend__().Timestamp;
+	Stamp.reset(new OutputManagerDetail::Timestamp<Char__>);
+	Stamp->Format = Format;
+	Stamp->Digits = std::min(Digits, 9u);
+	Stamp->Coarse = Coarse;
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef OUTPUTMANAGERENCODING_H
+#define OUTPUTMANAGERENCODING_H
+
+/**
+ * @file
+ * @brief The conversion of characters to the bytes the sinks writing to descriptors and shared memory send.
+ *
+ * @details Kept apart from OutputManagerCore.h so that AppendFile.h, SharedRing.h and PipeStream.h stay usable without the rest of the library.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include <locale>
+#include <string>
+#include <cwchar>
+#include <algorithm>
+#include <type_traits>
+
+namespace OutputManagerDetail {
+	/**
+	 * @brief Appends to `Bytes` the encoding of the characters between `Begin` and `End` by the `std::codecvt` of `Locale`.
+	 *
+	 * @details Narrow characters are copied as they are. Wide ones take as many bytes as the encoding of `Locale` needs, so with a UTF-8 locale every character is kept. A character the encoding cannot represent, such as any non-ASCII one in the classic `"C"` locale, is written as a single `?`.
+	 * @param State The shift state, kept from one call to the next by the caller.
+	 * @return The number of bytes appended.
+	 */
+	template<typename CharT> size_t Encode(std::locale const& Locale, const CharT* Begin, const CharT* End, std::string& Bytes, std::mbstate_t& State) {
+		const size_t Old = Bytes.size();
+		if constexpr (std::is_same_v<CharT, char>) {
+			Bytes.append(Begin, End);
+		}
+		else {
+			auto const& Converter = std::use_facet<std::codecvt<CharT, char, std::mbstate_t>>(Locale);
+			const size_t Longest = size_t(std::max(Converter.max_length(), 1));
+			size_t Used = Old;
+			while (Begin != End) {
+				if (Bytes.size() - Used < Longest) {
+					Bytes.resize(Used + size_t(End - Begin) * Longest);
+				}
+				const CharT* Next = Begin;
+				char* Out = nullptr;
+				const auto Result = Converter.out(State, Begin, End, Next, &Bytes[Used], &Bytes[0] + Bytes.size(), Out);
+				Used = Out - &Bytes[0];
+				Begin = Next;
+				//A partial result with room left is an incomplete character at the end.
+				if (Begin != End && (Result == std::codecvt_base::error || (Result == std::codecvt_base::partial && Bytes.size() - Used >= Longest))) {
+					if (Used == Bytes.size()) {
+						Bytes.resize(Used + 1);
+					}
+					Bytes[Used++] = '?';
+					++Begin;
+					State = std::mbstate_t();
+				}
+			}
+			Bytes.resize(Used);
+		}
+		return Bytes.size() - Old;
+	}
+}
+
+#endif
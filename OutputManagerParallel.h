@@ -0,0 +1,397 @@
+#ifndef OUTPUTMANAGERPARALLEL_H
+#define OUTPUTMANAGERPARALLEL_H
+
+/**
+ * @file
+ * @brief The thread pools of the library and OutputManager::ParallelFormatToRows(It, It, Its...).
+ *
+ * @details Kept apart from OutputManagerCore.h so that only translation units printing or parsing in parallel pay for `<thread>`, `<mutex>` and the other headers they need.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManagerCore.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+
+namespace OutputManagerDetail {
+	/**
+	 * @brief The task indices of a work-stealing pool, one deque per worker.
+	 *
+	 * @details Indices are dealt round-robin, so every deque holds increasing indices. A worker takes from the front of its own deque and, once it is empty, steals from the back of the others, which keeps uneven tasks balanced while the oldest tasks still go first.
+	 */
+	class StealingQueues {
+		private:
+			struct Queue {
+				std::mutex Lock;
+				std::deque<size_t> Indices;
+			};
+			std::vector<Queue> Queues__;
+		public:
+			/**
+			 * @brief Deals the indices from `0` to `Count` to `Workers` deques.
+			 */
+			StealingQueues(size_t Count, size_t Workers) : Queues__(Workers) {
+				for (size_t i = 0; i < Count; ++i) {
+					Queues__[i % Workers].Indices.push_back(i);
+				}
+			}
+			/**
+			 * @brief Takes the next index of worker `Self`, stealing it from another worker if its own deque is empty.
+			 * @return `false` if every deque is empty.
+			 */
+			bool Take(size_t Self, size_t& Index) {
+				const size_t Workers = Queues__.size();
+				for (size_t k = 0; k < Workers; ++k) {
+					Queue& Victim = Queues__[(Self + k) % Workers];
+					std::lock_guard<std::mutex> Guard(Victim.Lock);
+					if (!Victim.Indices.empty()) {
+						//Own queue from the front, stolen work from the back.
+						if (k == 0) {
+							Index = Victim.Indices.front();
+							Victim.Indices.pop_front();
+						}
+						else {
+							Index = Victim.Indices.back();
+							Victim.Indices.pop_back();
+						}
+						return true;
+					}
+				}
+				return false;
+			}
+			/**
+			 * @brief Takes `Index` if nobody took it yet and every smaller index is taken.
+			 */
+			bool TakeOldest(size_t Index) {
+				//The smaller indices of its deque are gone, so an index not taken yet is at the front.
+				Queue& Owner = Queues__[Index % Queues__.size()];
+				std::lock_guard<std::mutex> Guard(Owner.Lock);
+				if (Owner.Indices.empty() || Owner.Indices.front() != Index) {
+					return false;
+				}
+				Owner.Indices.pop_front();
+				return true;
+			}
+			/**
+			 * @brief Returns `true` once every index has been taken.
+			 */
+			bool Empty() {
+				for (auto& Owner : Queues__) {
+					std::lock_guard<std::mutex> Guard(Owner.Lock);
+					if (!Owner.Indices.empty()) {
+						return false;
+					}
+				}
+				return true;
+			}
+	};
+
+	/**
+	 * @brief Runs every task in `Tasks` on a small work-stealing pool and returns when all of them are done.
+	 *
+	 * @details The tasks are scheduled by StealingQueues, so uneven tasks still keep all cores busy. The calling thread works as the first worker. If a task throws, the first exception is rethrown after all workers have joined.
+	 * @param Tasks The tasks to run, in no particular order.
+	 * @param Workers The number of workers. If `0` it defaults to `std::thread::hardware_concurrency()`.
+	 */
+	inline void RunWorkStealing(std::vector<std::function<void()>>& Tasks, size_t Workers = 0) {
+		if (!Workers) {
+			Workers = std::max(1u, std::thread::hardware_concurrency());
+		}
+		Workers = std::min(Workers, Tasks.size());
+		if (Workers <= 1) {
+			for (auto& Task : Tasks) {
+				Task();
+			}
+			return;
+		}
+		StealingQueues Queues(Tasks.size(), Workers);
+		std::exception_ptr Error;
+		std::mutex ErrorLock;
+		auto Work = [&](size_t Self) {
+			size_t Index = 0;
+			//No task is ever added after start, so empty queues mean we are done.
+			while (Queues.Take(Self, Index)) {
+				try {
+					Tasks[Index]();
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> Guard(ErrorLock);
+					if (!Error) {
+						Error = std::current_exception();
+					}
+				}
+			}
+		};
+		std::vector<std::thread> Threads;
+		for (size_t w = 1; w < Workers; ++w) {
+			Threads.emplace_back(Work, w);
+		}
+		Work(0);
+		for (auto& Thread : Threads) {
+			Thread.join();
+		}
+		if (Error) {
+			std::rethrow_exception(Error);
+		}
+	}
+
+	/**
+	 * @brief Runs `Count` tasks on a work-stealing pool and hands their results over in order while the others are still running.
+	 *
+	 * @details The tasks are scheduled by StealingQueues, so uneven tasks still keep all cores busy. As soon as a task and all those before it are done, `Emit` is called for it, one call at a time and in index order, by one worker at a time and without holding any lock. While `Full()` returns `true` a worker only starts the oldest task not emitted yet, and waits if somebody else already runs it, so finished results waiting for an earlier one stop piling up until `Emit` drains them. If a task throws, no new task is started and the first exception is rethrown after all workers have joined.
+	 * @param Count The number of tasks.
+	 * @param Run Runs the task with the given index.
+	 * @param Emit Consumes the result of the task with the given index.
+	 * @param Full Returns `true` when no more results should be buffered.
+	 * @param Workers The number of workers. If `0` it defaults to `std::thread::hardware_concurrency()`.
+	 */
+	inline void RunOrdered(size_t Count, std::function<void(size_t)> const& Run, std::function<void(size_t)> const& Emit, std::function<bool()> const& Full, size_t Workers = 0) {
+		if (!Workers) {
+			Workers = std::max(1u, std::thread::hardware_concurrency());
+		}
+		Workers = std::min(Workers, Count);
+		if (Workers <= 1) {
+			for (size_t i = 0; i < Count; ++i) {
+				Run(i);
+				Emit(i);
+			}
+			return;
+		}
+		StealingQueues Queues(Count, Workers);
+		std::mutex Lock;
+		std::condition_variable Progress;
+		std::vector<char> Done(Count, 0);
+		size_t Next = 0;
+		bool Emitting = false;
+		bool Failed = false;
+		std::exception_ptr Error;
+		auto Fail = [&]() {
+			Failed = true;
+			if (!Error) {
+				Error = std::current_exception();
+			}
+			Progress.notify_all();
+		};
+		//Returns `false` when there is nothing left to start.
+		auto Claim = [&](size_t Self, size_t& Index) {
+			std::unique_lock<std::mutex> Guard(Lock);
+			while (!Failed && Full()) {
+				//The oldest task always runs, so the others can wait for it without deadlocking.
+				if (Next < Count && Queues.TakeOldest(Next)) {
+					Index = Next;
+					return true;
+				}
+				if (Queues.Empty()) {
+					return false;
+				}
+				const size_t Seen = Next;
+				Progress.wait(Guard, [&]() {
+					return Failed || Next != Seen || !Full();
+				});
+			}
+			if (Failed) {
+				return false;
+			}
+			Guard.unlock();
+			return Queues.Take(Self, Index);
+		};
+		auto Work = [&](size_t Self) {
+			size_t Index = 0;
+			while (Claim(Self, Index)) {
+				try {
+					Run(Index);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> Guard(Lock);
+					Fail();
+					return;
+				}
+				std::unique_lock<std::mutex> Guard(Lock);
+				Done[Index] = 1;
+				if (Emitting) {
+					//The worker emitting will see this task once it gets to it.
+					continue;
+				}
+				//Emit without the lock, so the others keep claiming and finishing tasks meanwhile.
+				Emitting = true;
+				while (!Failed && Next < Count && Done[Next]) {
+					const size_t Current = Next;
+					Guard.unlock();
+					try {
+						Emit(Current);
+					}
+					catch (...) {
+						Guard.lock();
+						Emitting = false;
+						Fail();
+						return;
+					}
+					Guard.lock();
+					++Next;
+					Progress.notify_all();
+				}
+				Emitting = false;
+			}
+		};
+		std::vector<std::thread> Threads;
+		for (size_t w = 1; w < Workers; ++w) {
+			Threads.emplace_back(Work, w);
+		}
+		Work(0);
+		for (auto& Thread : Threads) {
+			Thread.join();
+		}
+		if (Error) {
+			std::rethrow_exception(Error);
+		}
+	}
+}
+
+namespace OutputManagerDetail {
+	/**
+	 * @brief Prints in rows for OutputManager::ParallelFormatToRows(It, It, Its...), as a friend of OutputManager.
+	 */
+	template<typename It> struct ParallelRows {
+		template<typename OutType, typename StringType, typename... Its> static void Print(OutputManager<OutType, StringType>& Manager, It Begin, It End, Its... Others);
+	};
+}
+
+//
+//FORMATTERS
+//
+template<typename It>
+template<typename OutType, typename StringType, typename... Its>
+void OutputManagerDetail::ParallelRows<It> ::Print(OutputManager<OutType, StringType>& Manager, It Begin, It End, Its... Others) {
+	using Char__ = typename OutType::char_type;
+	using RowManager = OutputManager<typename OutputManager<OutType, StringType>::BufferStream__, StringType>;
+	using RowBuffer = std::basic_ostringstream<typename OutType::char_type, typename OutType::traits_type>;
+	struct Chunk {
+		std::basic_string<Char__, typename OutType::traits_type> Text;
+		//Where the text went in the spill file, if it did not fit in memory.
+		long Offset = -1;
+		size_t Length = 0;
+	};
+	const size_t Length = std::distance(Begin, End);
+	OutputManagerDetail::Limits& Limits = Manager.MakeLimits__();
+	const size_t Workers = Limits.Workers ? Limits.Workers : std::max(1u, std::thread::hardware_concurrency());
+	//Enough chunks to keep every worker busy, but not so small that scheduling dominates.
+	size_t ChunkLength = std::max<size_t>(256, Length * (1 + sizeof...(Its)) / (4 * Workers) + 1);
+	if (Limits.MemoryCap) {
+		//Small enough that a few chunks per worker fit in the cap, guessing about 16 characters per element.
+		ChunkLength = std::min(ChunkLength, std::max<size_t>(256, Limits.MemoryCap / (64 * sizeof(Char__) * Workers)));
+	}
+	//The workers copy their settings from here, so they never touch the stream while chunks are being written to it.
+	RowBuffer Settings;
+	RowManager Prototype(Settings);
+	Manager.CopySettingsTo__(Prototype);
+	std::deque<Chunk> Chunks;
+	std::vector<std::function<void(Chunk&)>> Tasks;
+	auto Schedule = [&](auto RowBegin) {
+		size_t Done = 0;
+		do {
+			const size_t Count = std::min(ChunkLength, Length - Done);
+			auto ChunkEnd = RowBegin;
+			std::advance(ChunkEnd, Count);
+			Done += Count;
+			const bool Last = Done == Length;
+			Chunks.emplace_back();
+			Tasks.emplace_back([&Prototype, RowBegin, ChunkEnd, Last, Column = Done - Count](Chunk& Target) {
+				RowBuffer Buffer;
+				RowManager Row(Buffer);
+				Prototype.CopySettingsTo__(Row);
+				Row.Refresh__();
+				//Only the first chunk of a row starts a line, the time is read when it is formatted.
+				if (!Column && RowBegin != ChunkEnd) {
+					Row.StartLine__();
+				}
+				Row.PrintElements__(RowBegin, ChunkEnd, Column);
+				if (Last) {
+					Row.Append__(Row.EndOfLine__);
+				}
+				Row.Flush__();
+				Target.Text = Buffer.str();
+			});
+			RowBegin = ChunkEnd;
+		} while (Done != Length);
+	};
+	Schedule(Begin);
+	(Schedule(Others),...);
+	std::unique_ptr<std::FILE, int(*)(std::FILE*)> Spill(nullptr, &std::fclose);
+	std::mutex SpillLock;
+	//The buffer of Manager is left alone until the workers are done, so its size can be read once here.
+	const size_t Held = Manager.Buffer__.Capacity() * sizeof(Char__);
+	const size_t Block = Manager.BlockLength__(1);
+	std::unique_ptr<Char__[]> ReadBack;
+	auto Run = [&](size_t Index) {
+		Chunk& Target = Chunks[Index];
+		Tasks[Index](Target);
+		const size_t Bytes = Target.Text.size() * sizeof(Char__);
+		const size_t Total = Limits.Pending.fetch_add(Bytes) + Bytes;
+		Manager.Track__(Held + Total);
+		if (Limits.MemoryCap && Limits.Overflow > 0 && Total > Limits.MemoryCap) {
+			std::lock_guard<std::mutex> Guard(SpillLock);
+			if (!Spill) {
+				Spill.reset(std::tmpfile());
+			}
+			if (Spill && !std::fseek(Spill.get(), 0, SEEK_END)) {
+				const long Offset = std::ftell(Spill.get());
+				if (Offset >= 0 && std::fwrite(Target.Text.data(), sizeof(Char__), Target.Text.size(), Spill.get()) == Target.Text.size()) {
+					Target.Offset = Offset;
+					Target.Length = Target.Text.size();
+					Target.Text = {};
+					Limits.Pending -= Bytes;
+				}
+			}
+			//Without a usable temporary file the chunk simply stays in memory.
+		}
+	};
+	auto Emit = [&](size_t Index) {
+		Chunk& Target = Chunks[Index];
+		if (Target.Offset < 0) {
+			Manager.OutStream__.write(Target.Text.data(), Target.Text.size());
+			Limits.Pending -= Target.Text.size() * sizeof(Char__);
+			Target.Text = {};
+			return;
+		}
+		//Read back in blocks, so draining does not need the memory the spill saved. Only one worker emits at a time, so the block is not shared.
+		if (!ReadBack) {
+			ReadBack.reset(new Char__[Block]);
+			Manager.Track__(Held + Block * sizeof(Char__) + Limits.Pending);
+		}
+		for (size_t Done = 0; Done < Target.Length;) {
+			size_t Count = 0;
+			{
+				std::lock_guard<std::mutex> Guard(SpillLock);
+				std::fflush(Spill.get());
+				if (!std::fseek(Spill.get(), Target.Offset + long(Done * sizeof(Char__)), SEEK_SET)) {
+					Count = std::fread(ReadBack.get(), sizeof(Char__), std::min(Block, Target.Length - Done), Spill.get());
+				}
+			}
+			if (!Count) {
+				throw std::runtime_error("OutputManager: cannot read back the spill file");
+			}
+			Manager.OutStream__.write(ReadBack.get(), Count);
+			Done += Count;
+		}
+	};
+	auto Full = [&]() {
+		return Limits.MemoryCap && Limits.Overflow <= 0 && Limits.Pending >= Limits.MemoryCap;
+	};
+	OutputManagerDetail::RunOrdered(Chunks.size(), Run, Emit, Full, Workers);
+	return;
+}
+
+#endif
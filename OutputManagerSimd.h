@@ -0,0 +1,137 @@
+#ifndef OUTPUTMANAGERSIMD_H
+#define OUTPUTMANAGERSIMD_H
+
+/**
+ * @file
+ * @brief The SIMD kernels of the library and the detection of the CPU features picking them at run time.
+ *
+ * @details Without this header every kernel runs its scalar version, which gives the same output. Including it in any translation unit registers the pickers of the kernels for the whole program, at the price of `<immintrin.h>` in that translation unit. The CPU is only inspected by the first call of each kernel, which binds the widest version the CPU supports. A kernel first called before the registration, from the static initialisation of another translation unit, stays scalar. InputManager.h includes it.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManagerCore.h"
+#include <cstdlib>
+#include <cstring>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+/**
+ * @brief Defined when SIMD kernels are compiled for several instruction sets and picked at run time, see OutputManagerDetail::Cpu().
+ */
+#define OUTPUTMANAGER_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace OutputManagerDetail {
+	/**
+	 * @brief The instruction sets the SIMD kernels can use on this machine.
+	 */
+	struct CpuFeatures {
+		bool Sse2 = false;
+		bool Ssse3 = false;
+		bool Avx2 = false;
+		bool Avx512bw = false;
+	};
+	/**
+	 * @brief Detects the features of the CPU, once for the whole program.
+	 *
+	 * @details Every kernel with SIMD variants binds the best one for these features once, so a single binary uses AVX-512 or AVX2 where they are available and still runs on older machines. If the environment variable `OUTPUTMANAGER_FORCE_SCALAR` is set to anything but `0` no feature is reported and only the scalar kernels are used, which helps to tell a kernel bug from a caller bug. Without `OUTPUTMANAGER_DISPATCH` no feature is ever reported.
+	 */
+	inline CpuFeatures const& Cpu() {
+		static const CpuFeatures Features = []() {
+			CpuFeatures Detected;
+			const char* Force = std::getenv("OUTPUTMANAGER_FORCE_SCALAR");
+			if (Force && *Force && std::strcmp(Force, "0")) {
+				return Detected;
+			}
+#if defined(OUTPUTMANAGER_DISPATCH)
+			__builtin_cpu_init();
+			Detected.Sse2 = __builtin_cpu_supports("sse2");
+			Detected.Ssse3 = __builtin_cpu_supports("ssse3");
+			Detected.Avx2 = __builtin_cpu_supports("avx2");
+			Detected.Avx512bw = __builtin_cpu_supports("avx512bw");
+#endif
+			return Detected;
+		}();
+		return Features;
+	}
+
+#if defined(OUTPUTMANAGER_DISPATCH)
+	/**
+	 * @brief HexBytesScalar() sixteen bytes at a time: the bytes are split in nibbles, which are turned into digits with a single byte shuffle and interleaved back.
+	 */
+	__attribute__((target("ssse3"))) inline void HexBytesSsse3(char* Out, unsigned char const* In, size_t Count, bool Upper) {
+		const __m128i Digits = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Upper ? "0123456789ABCDEF" : "0123456789abcdef"));
+		const __m128i Mask = _mm_set1_epi8(0x0F);
+		size_t i = 0;
+		for (; i + 16 <= Count; i += 16) {
+			const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(In + i));
+			const __m128i High = _mm_shuffle_epi8(Digits, _mm_and_si128(_mm_srli_epi16(Bytes, 4), Mask));
+			const __m128i Low = _mm_shuffle_epi8(Digits, _mm_and_si128(Bytes, Mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + 2 * i), _mm_unpacklo_epi8(High, Low));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + 2 * i + 16), _mm_unpackhi_epi8(High, Low));
+		}
+		HexBytesScalar(Out + 2 * i, In + i, Count - i, Upper);
+	}
+	/**
+	 * @brief HexBytesSsse3() thirty-two bytes at a time. Shuffles and interleaving work within 128 bit lanes, so the two halves are swapped back in place before storing.
+	 */
+	__attribute__((target("avx2"))) inline void HexBytesAvx2(char* Out, unsigned char const* In, size_t Count, bool Upper) {
+		const __m256i Digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(Upper ? "0123456789ABCDEF" : "0123456789abcdef")));
+		const __m256i Mask = _mm256_set1_epi8(0x0F);
+		size_t i = 0;
+		for (; i + 32 <= Count; i += 32) {
+			const __m256i Bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(In + i));
+			const __m256i High = _mm256_shuffle_epi8(Digits, _mm256_and_si256(_mm256_srli_epi16(Bytes, 4), Mask));
+			const __m256i Low = _mm256_shuffle_epi8(Digits, _mm256_and_si256(Bytes, Mask));
+			const __m256i First = _mm256_unpacklo_epi8(High, Low);
+			const __m256i Second = _mm256_unpackhi_epi8(High, Low);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + 2 * i), _mm256_permute2x128_si256(First, Second, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + 2 * i + 32), _mm256_permute2x128_si256(First, Second, 0x31));
+		}
+		HexBytesSsse3(Out + 2 * i, In + i, Count - i, Upper);
+	}
+	/**
+	 * @brief HexBytesAvx2() sixty-four bytes at a time. The four 128 bit lanes are interleaved within themselves, so the halves of each lane are gathered back in order with a two-source permutation.
+	 */
+	__attribute__((target("avx512bw"))) inline void HexBytesAvx512(char* Out, unsigned char const* In, size_t Count, bool Upper) {
+		const __m512i Digits = _mm512_loadu_si512(Upper ? "0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF" : "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef");
+		const __m512i Mask = _mm512_set1_epi8(0x0F);
+		const __m512i Front = _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0);
+		const __m512i Back = _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4);
+		size_t i = 0;
+		for (; i + 64 <= Count; i += 64) {
+			const __m512i Bytes = _mm512_loadu_si512(In + i);
+			const __m512i High = _mm512_shuffle_epi8(Digits, _mm512_and_si512(_mm512_srli_epi16(Bytes, 4), Mask));
+			const __m512i Low = _mm512_shuffle_epi8(Digits, _mm512_and_si512(Bytes, Mask));
+			const __m512i First = _mm512_unpacklo_epi8(High, Low);
+			const __m512i Second = _mm512_unpackhi_epi8(High, Low);
+			_mm512_storeu_si512(Out + 2 * i, _mm512_permutex2var_epi64(First, Front, Second));
+			_mm512_storeu_si512(Out + 2 * i + 64, _mm512_permutex2var_epi64(First, Back, Second));
+		}
+		HexBytesAvx2(Out + 2 * i, In + i, Count - i, Upper);
+	}
+#endif
+	/**
+	 * @brief The widest of HexBytesAvx512(), HexBytesAvx2(), HexBytesSsse3() and HexBytesScalar() supported by Cpu().
+	 */
+	inline HexKernel PickHexBytes() {
+#if defined(OUTPUTMANAGER_DISPATCH)
+		if (Cpu().Avx512bw) {
+			return HexBytesAvx512;
+		}
+		if (Cpu().Avx2) {
+			return HexBytesAvx2;
+		}
+		if (Cpu().Ssse3) {
+			return HexBytesSsse3;
+		}
+#endif
+		return HexBytesScalar;
+	}
+	/**
+	 * @brief Registers PickHexBytes() as HexBytesPicker during static initialisation. Nothing is picked until HexBytes() is first called.
+	 */
+	inline const bool HexBytesPickable = (HexBytesPicker = PickHexBytes, true);
+}
+
+#endif
@@ -0,0 +1,339 @@
+#ifndef PIPESTREAM_H
+#define PIPESTREAM_H
+
+/**
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <ostream>
+#include <streambuf>
+#include <locale>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <type_traits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <sys/uio.h>
+#endif
+#include <string>
+#include "OutputManagerEncoding.h"
+
+/**
+ * @brief An output stream writing to a pipe or socket without blocking while there is room to buffer.
+ *
+ * @details The descriptor is switched to non-blocking mode and output is copied into a ring of `Capacity` bytes. Whenever `BatchSize` bytes have been added since the last try, as much as the reader takes is written in one go; if it takes nothing the stream carries on buffering. Only when the ring is full, or on a flush, does the stream wait with `poll` for the descriptor to become writable.
+ * @details On Linux, if the descriptor is a pipe and `Splice` is `true`, the ring pages are handed to the pipe with `vmsplice` instead of being copied by `write`. Pages the pipe still refers to are never written again: once sent they are dropped with `madvise` and come back as new pages.
+ * @details Stats() reports how often the reader lagged and how long the stream waited for it. Wide characters are encoded by the `std::codecvt` of the locale of the stream, see OutputManagerDetail::Encode(): imbue a UTF-8 locale to keep every character.
+ *
+ * **Example:**
+ * ```.cpp
+ * #include "OutputManager.h"
+ * #include "PipeStream.h"
+ *
+ * int main () {
+ *     PipeStream Pipe(STDOUT_FILENO);
+ *     OutputManager O(Pipe);
+ *     for (int i = 0; i < 1000000; ++i) {
+ *         O(i, i * 0.5);
+ *     }
+ *     Pipe.flush();
+ *     std::wcerr << Pipe.Stats().WouldBlock << L" times the reader lagged\n";
+ * }
+ * ```
+ * @tparam CharT The character type of the stream.
+ * @tparam Traits The character traits of the stream.
+ * @warning Non-blocking mode belongs to the open file, so other processes sharing it see it too until the stream is destroyed and the original flags are restored.
+ */
+template<typename CharT = wchar_t, typename Traits = std::char_traits<CharT>> class PipeStream : public std::basic_ostream<CharT, Traits> {
+	public:
+		/**
+		 * @brief Counters of a PipeStream.
+		 */
+		struct Statistics {
+			/**
+			 * @brief The number of successful `write` or `vmsplice` calls.
+			 */
+			size_t Writes = 0;
+			/**
+			 * @brief The number of bytes written.
+			 */
+			size_t Bytes = 0;
+			/**
+			 * @brief The number of times the reader took nothing because it lagged.
+			 */
+			size_t WouldBlock = 0;
+			/**
+			 * @brief The number of times the stream waited for the reader, because the ring was full or on a flush.
+			 */
+			size_t Stalls = 0;
+			/**
+			 * @brief The time spent waiting for the reader, in nanoseconds.
+			 */
+			uint64_t StallNanoseconds = 0;
+		};
+
+	protected:
+		/**
+		 * @brief The stream buffer keeping the ring and writing it out.
+		 */
+		class PipeBuffer__ : public std::basic_streambuf<CharT, Traits> {
+			protected:
+				using Int__ = typename Traits::int_type;
+
+				/**
+				 * @brief The descriptor written to.
+				 */
+				int Descriptor__;
+				/**
+				 * @brief The flags of the descriptor before it was made non-blocking.
+				 */
+				int Flags__;
+				/**
+				 * @brief `true` if pages are handed over with `vmsplice`.
+				 */
+				bool Splice__ = false;
+				/**
+				 * @brief `true` once writing failed for good.
+				 */
+				bool Failed__ = false;
+				/**
+				 * @brief The size of a page.
+				 */
+				size_t Page__;
+				/**
+				 * @brief The size of the ring, a multiple of the page size.
+				 */
+				size_t Capacity__;
+				/**
+				 * @brief The number of bytes added after which a write is tried.
+				 */
+				size_t Batch__;
+				/**
+				 * @brief The ring.
+				 */
+				char* Ring__;
+				/**
+				 * @brief The number of bytes ever written out, added and added when a write was last tried.
+				 */
+				uint64_t Begin__ = 0, End__ = 0, Tried__ = 0;
+				/**
+				 * @brief The position up to which spliced pages were dropped.
+				 */
+				uint64_t Dropped__ = 0;
+				Statistics Stats__;
+				/**
+				 * @brief The encoding of the text being written, for wide streams.
+				 */
+				std::string Encoded__;
+				/**
+				 * @brief The shift state of the encoding.
+				 */
+				std::mbstate_t State__{};
+
+				/**
+				 * @brief The room left in the ring. With `vmsplice` the page holding `Begin__` may still be read by the pipe, so it is not reused until fully sent.
+				 */
+				size_t Free__() const {
+					const uint64_t Limit = Splice__ ? Begin__ / Page__ * Page__ : Begin__;
+					return Limit + Capacity__ - End__;
+				}
+				/**
+				 * @brief Drops the pages fully sent up to `Begin__`, so that the next writes to them get new pages instead of changing what the pipe holds.
+				 */
+				void Drop__() {
+					while (Dropped__ + Page__ <= Begin__) {
+						const size_t Offset = Dropped__ % Capacity__;
+						const size_t Size = std::min<uint64_t>(Begin__ / Page__ * Page__ - Dropped__, Capacity__ - Offset);
+						madvise(Ring__ + Offset, Size, MADV_DONTNEED);
+						Dropped__ += Size;
+					}
+				}
+				/**
+				 * @brief Waits for the descriptor to become writable, counting the stall.
+				 * @return `false` if the reader is gone or polling failed.
+				 */
+				bool Poll__() {
+					const auto Start = std::chrono::steady_clock::now();
+					pollfd Request{Descriptor__, POLLOUT, 0};
+					int Result;
+					while ((Result = poll(&Request, 1, -1)) < 0 && errno == EINTR) {}
+					++Stats__.Stalls;
+					Stats__.StallNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count();
+					return Result > 0 && !(Request.revents & (POLLERR | POLLNVAL));
+				}
+				/**
+				 * @brief Writes out the ring, until the reader takes nothing, or until it is empty if `Wait` is `true`.
+				 * @return `false` if writing failed.
+				 */
+				bool Send__(bool Wait) {
+					Tried__ = End__;
+					while (!Failed__ && Begin__ < End__) {
+						const size_t Offset = Begin__ % Capacity__;
+						const size_t Size = std::min<uint64_t>(End__ - Begin__, Capacity__ - Offset);
+						ssize_t Result;
+#if defined(__linux__)
+						if (Splice__) {
+							iovec Span{Ring__ + Offset, Size};
+							Result = vmsplice(Descriptor__, &Span, 1, SPLICE_F_NONBLOCK);
+						}
+						else
+#endif
+						Result = write(Descriptor__, Ring__ + Offset, Size);
+						if (Result > 0) {
+							++Stats__.Writes;
+							Stats__.Bytes += Result;
+							Begin__ += Result;
+							if (Splice__) {
+								Drop__();
+							}
+						}
+						else if (Result < 0 && errno == EINTR) {
+							continue;
+						}
+						else if (Result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+							++Stats__.WouldBlock;
+							if (!Wait) {
+								break;
+							}
+							Failed__ = !Poll__();
+						}
+						else {
+							Failed__ = true;
+						}
+					}
+					return !Failed__;
+				}
+
+				std::streamsize xsputn(const CharT* Text, std::streamsize Count) override {
+					const char* Bytes = nullptr;
+					size_t Size = 0;
+					if constexpr (std::is_same_v<CharT, char>) {
+						Bytes = Text;
+						Size = Count;
+					}
+					else {
+						Encoded__.clear();
+						OutputManagerDetail::Encode(this->getloc(), Text, Text + Count, Encoded__, State__);
+						Bytes = Encoded__.data();
+						Size = Encoded__.size();
+					}
+					for (size_t Done = 0; Done < Size;) {
+						if (Failed__) {
+							//The characters behind part of an encoding cannot be told apart, so a wide write fails as a whole.
+							return std::is_same_v<CharT, char> ? std::streamsize(Done) : 0;
+						}
+						if (!Free__()) {
+							//The ring is full, so the reader must make room.
+							if (Send__(false) && !Free__()) {
+								Failed__ = !Poll__();
+							}
+							continue;
+						}
+						const size_t Offset = End__ % Capacity__;
+						const size_t Piece = std::min({Size - Done, Free__(), Capacity__ - Offset});
+						std::memcpy(Ring__ + Offset, Bytes + Done, Piece);
+						End__ += Piece;
+						Done += Piece;
+					}
+					if (End__ - Tried__ >= Batch__ && !Send__(false)) {
+						return 0;
+					}
+					return Count;
+				}
+				Int__ overflow(Int__ Character) override {
+					if (!Traits::eq_int_type(Character, Traits::eof())) {
+						const CharT Value = Traits::to_char_type(Character);
+						if (xsputn(&Value, 1) != 1) {
+							return Traits::eof();
+						}
+					}
+					return Traits::not_eof(Character);
+				}
+				int sync() override {
+					return Send__(true) ? 0 : -1;
+				}
+
+			public:
+				PipeBuffer__(int Descriptor, size_t Capacity, size_t BatchSize, bool Splice) : Descriptor__{Descriptor}, Page__(sysconf(_SC_PAGESIZE)), Batch__{BatchSize} {
+					Capacity__ = std::max<size_t>((Capacity + Page__ - 1) / Page__, 2) * Page__;
+					void* Map = mmap(nullptr, Capacity__, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if (Map == MAP_FAILED) {
+						throw std::system_error(errno, std::generic_category(), "PipeStream: cannot map the buffer");
+					}
+					Ring__ = static_cast<char*>(Map);
+					Flags__ = fcntl(Descriptor__, F_GETFL);
+					if (Flags__ < 0 || fcntl(Descriptor__, F_SETFL, Flags__ | O_NONBLOCK) < 0) {
+						const int Error = errno;
+						munmap(Ring__, Capacity__);
+						throw std::system_error(Error, std::generic_category(), "PipeStream: cannot make the descriptor non-blocking");
+					}
+#if defined(__linux__)
+					struct stat Status;
+					Splice__ = Splice && fstat(Descriptor__, &Status) == 0 && S_ISFIFO(Status.st_mode);
+#else
+					(void)Splice;
+#endif
+				}
+				~PipeBuffer__() override {
+					Send__(true);
+					fcntl(Descriptor__, F_SETFL, Flags__);
+					munmap(Ring__, Capacity__);
+				}
+
+				Statistics const& Stats() const {
+					return Stats__;
+				}
+		};
+
+		/**
+		 * @brief The buffer of the stream.
+		 */
+		PipeBuffer__ Pipe__;
+
+	public:
+		PipeStream(PipeStream const&) = delete;
+		PipeStream& operator=(PipeStream const&) = delete;
+
+		/**
+		 * @brief Writes to an open descriptor, such as a pipe or a socket. The descriptor is not closed.
+		 * @param Capacity The size in bytes of the ring, rounded up to whole pages.
+		 * @param BatchSize The number of bytes added after which a write is tried.
+		 * @param Splice `true` to hand pages to pipes with `vmsplice` on Linux.
+		 * @throw std::system_error If the ring cannot be allocated or the descriptor made non-blocking.
+		 */
+		explicit PipeStream(int FileDescriptor, size_t Capacity = 1 << 20, size_t BatchSize = 1 << 16, bool Splice = true);
+
+		/**
+		 * @brief The counters of the stream so far.
+		 */
+		Statistics const& Stats() const;
+};
+
+//
+//CONSTRUCTORS
+//
+template<typename CharT, typename Traits>
+PipeStream<CharT, Traits> ::PipeStream(int FileDescriptor, size_t Capacity, size_t BatchSize, bool Splice) : std::basic_ostream<CharT, Traits>(nullptr), Pipe__(FileDescriptor, Capacity, BatchSize, Splice) {
+	this->init(&Pipe__);
+}
+
+//
+//STATISTICS
+//
+template<typename CharT, typename Traits>
+typename PipeStream<CharT, Traits>::Statistics const& PipeStream<CharT, Traits> ::Stats() const {
+	return Pipe__.Stats();
+}
+
+#endif
+#endif
@@ -0,0 +1,367 @@
+#ifndef SHAREDRING_H
+#define SHAREDRING_H
+
+/**
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <locale>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <system_error>
+#include <stdexcept>
+#include <type_traits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "OutputManagerEncoding.h"
+
+namespace SharedRingDetail {
+	/**
+	 * @brief Marks a record written by a producer as filler up to the end of the ring.
+	 */
+	constexpr uint32_t Padding = 1u << 31;
+	/**
+	 * @brief Set once the ring is ready, with its layout version.
+	 */
+	constexpr uint64_t Magic = 0x4F4D52494E470001;
+
+	/**
+	 * @brief The start of the shared memory object, followed by the ring.
+	 *
+	 * @details Records start at multiples of 8 bytes with a 4 byte length, which is 0 until the record is written, and are padded to a multiple of 8. A record that does not fit before the end of the ring is preceded by a padding record covering the rest of it.
+	 */
+	struct Header {
+		/**
+		 * @brief `Magic` once the creator initialised the ring.
+		 */
+		std::atomic<uint64_t> Ready;
+		/**
+		 * @brief The size of the ring in bytes.
+		 */
+		uint64_t Capacity;
+		/**
+		 * @brief The position up to which producers reserved space.
+		 */
+		alignas(64) std::atomic<uint64_t> Head;
+		/**
+		 * @brief The position up to which the reader freed space.
+		 */
+		alignas(64) std::atomic<uint64_t> Read;
+	};
+	static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "SharedRing needs lock free atomics to share them between processes.");
+
+	/**
+	 * @brief The shared memory object with the ring, created if it does not exist.
+	 */
+	class Mapping {
+		protected:
+			Header* Header__ = nullptr;
+			char* Ring__ = nullptr;
+			size_t Size__ = 0;
+
+			/**
+			 * @brief The length word of the record at `Offset`.
+			 */
+			std::atomic<uint32_t>& Word__(uint64_t Offset) const {
+				return *reinterpret_cast<std::atomic<uint32_t>*>(Ring__ + Offset);
+			}
+
+		public:
+			Mapping(Mapping const&) = delete;
+			Mapping& operator=(Mapping const&) = delete;
+
+			/**
+			 * @brief Opens the shared memory object `Name`, or creates it with a ring of `Capacity` bytes, rounded up to a multiple of 8.
+			 * @throw std::runtime_error If `Capacity` is below 64 bytes or not below 2 GiB, since record lengths leave their top bit to `Padding`.
+			 * @throw std::system_error If the object cannot be created, sized or mapped.
+			 */
+			Mapping(std::string const& Name, size_t Capacity) {
+				Capacity = (Capacity + 7) & ~size_t(7);
+				if (Capacity < 64 || Capacity >= Padding) {
+					throw std::runtime_error("SharedRing: the capacity must be at least 64 bytes and below 2 GiB");
+				}
+				bool Created = true;
+				int Descriptor = shm_open(Name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+				if (Descriptor < 0 && errno == EEXIST) {
+					Created = false;
+					Descriptor = shm_open(Name.c_str(), O_RDWR, 0666);
+				}
+				if (Descriptor < 0) {
+					throw std::system_error(errno, std::generic_category(), "SharedRing: cannot open " + Name);
+				}
+				if (Created && ftruncate(Descriptor, sizeof(Header) + Capacity) < 0) {
+					const int Error = errno;
+					close(Descriptor);
+					shm_unlink(Name.c_str());
+					throw std::system_error(Error, std::generic_category(), "SharedRing: cannot size " + Name);
+				}
+				//The creator may not have sized the object yet.
+				struct stat Status;
+				do {
+					if (fstat(Descriptor, &Status) < 0) {
+						const int Error = errno;
+						close(Descriptor);
+						throw std::system_error(Error, std::generic_category(), "SharedRing: cannot stat " + Name);
+					}
+				} while (size_t(Status.st_size) <= sizeof(Header) && (sched_yield(), true));
+				Size__ = Status.st_size;
+				void* Map = mmap(nullptr, Size__, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0);
+				const int Error = errno;
+				close(Descriptor);
+				if (Map == MAP_FAILED) {
+					throw std::system_error(Error, std::generic_category(), "SharedRing: cannot map " + Name);
+				}
+				Header__ = static_cast<Header*>(Map);
+				Ring__ = static_cast<char*>(Map) + sizeof(Header);
+				if (Created) {
+					Header__->Capacity = Size__ - sizeof(Header);
+					Header__->Ready.store(Magic, std::memory_order_release);
+				}
+				else {
+					while (Header__->Ready.load(std::memory_order_acquire) != Magic) {
+						sched_yield();
+					}
+				}
+			}
+			~Mapping() {
+				munmap(Header__, Size__);
+			}
+
+			/**
+			 * @brief The size of the ring in bytes.
+			 */
+			size_t Capacity() const {
+				return Header__->Capacity;
+			}
+	};
+}
+
+/**
+ * @brief An output stream writing into a ring buffer in POSIX shared memory, drained by another process with a SharedRingReader.
+ *
+ * @details Text is kept until the end of its line, then the complete lines of every write to the stream, that is of every printer of an OutputManager, become a single record in the ring: space is reserved with a compare and swap, the text is copied in and the record is published by storing its length. A flush sends an incomplete line as well. Any number of processes and threads can write to the same ring, while a single reader drains it. No system call is made unless the ring is full, in which case writers yield until the reader makes room and FullWaits() counts how often.
+ * @details The ring is created by whoever opens it first, with the capacity that one asked for. Records hold at most a quarter of the ring, so only lines longer than that are split into several records, which other writers may interleave. Wide characters are encoded by the `std::codecvt` of the locale of the stream, see OutputManagerDetail::Encode(): imbue a UTF-8 locale to keep every character.
+ *
+ * **Example:**
+ * ```.cpp
+ * #include "OutputManager.h"
+ * #include "SharedRing.h"
+ *
+ * int main () {
+ *     SharedRing Ring("/outputmanager", 1 << 24);
+ *     OutputManager O(Ring);
+ *     for (int i = 0; i < 1000000; ++i) {
+ *         O(i, i * 0.5);
+ *     }
+ * }
+ * ```
+ * Meanwhile, `SharedRingReader /outputmanager output.txt` writes the lines to `output.txt`.
+ * @tparam CharT The character type of the stream.
+ * @tparam Traits The character traits of the stream.
+ * @warning The shared memory object outlives the processes using it, remove it with `shm_unlink` once every writer and the reader are done.
+ */
+template<typename CharT = wchar_t, typename Traits = std::char_traits<CharT>> class SharedRing : public std::basic_ostream<CharT, Traits> {
+	protected:
+		/**
+		 * @brief The stream buffer copying every write into the ring.
+		 */
+		class RingBuffer__ : public std::basic_streambuf<CharT, Traits>, public SharedRingDetail::Mapping {
+			protected:
+				using Int__ = typename Traits::int_type;
+
+				/**
+				 * @brief The encoded text not sent yet, which is the incomplete last line.
+				 */
+				std::string Line__;
+				/**
+				 * @brief The shift state of the encoding.
+				 */
+				std::mbstate_t State__{};
+				/**
+				 * @brief The number of times a write waited for the reader.
+				 */
+				size_t Waits__ = 0;
+
+				/**
+				 * @brief Copies `Size` bytes into a single record, waiting for room if the ring is full.
+				 */
+				void Push__(const char* Data, uint32_t Size) {
+					const uint64_t Capacity = Header__->Capacity;
+					const uint64_t Need = 8 + ((uint64_t(Size) + 7) & ~uint64_t(7));
+					uint64_t Head = Header__->Head.load(std::memory_order_relaxed);
+					uint64_t Skip = 0;
+					while (true) {
+						Skip = Head % Capacity + Need > Capacity ? Capacity - Head % Capacity : 0;
+						if (Head + Skip + Need - Header__->Read.load(std::memory_order_acquire) > Capacity) {
+							++Waits__;
+							sched_yield();
+							Head = Header__->Head.load(std::memory_order_relaxed);
+						}
+						else if (Header__->Head.compare_exchange_weak(Head, Head + Skip + Need, std::memory_order_relaxed)) {
+							break;
+						}
+					}
+					if (Skip) {
+						Word__(Head % Capacity).store(uint32_t(Skip) | SharedRingDetail::Padding, std::memory_order_release);
+					}
+					const uint64_t Offset = (Head + Skip) % Capacity;
+					std::memcpy(Ring__ + Offset + 8, Data, Size);
+					Word__(Offset).store(Size, std::memory_order_release);
+				}
+
+				/**
+				 * @brief Sends the first `End` bytes of `Line__` in as few records as possible, splitting only lines longer than a record.
+				 */
+				void Send__(size_t End) {
+					const size_t Largest = Capacity() / 4 - 8;
+					for (size_t Start = 0; Start < End;) {
+						size_t Stop = End;
+						if (Stop - Start > Largest) {
+							Stop = Start + Largest;
+							const size_t Last = Line__.rfind('\n', Stop - 1);
+							if (Last != std::string::npos && Last >= Start) {
+								Stop = Last + 1;
+							}
+						}
+						Push__(Line__.data() + Start, uint32_t(Stop - Start));
+						Start = Stop;
+					}
+					Line__.erase(0, End);
+				}
+
+				std::streamsize xsputn(const CharT* Text, std::streamsize Count) override {
+					const size_t Old = Line__.size();
+					OutputManagerDetail::Encode(this->getloc(), Text, Text + Count, Line__, State__);
+					const size_t Last = Line__.rfind('\n');
+					if (Last != std::string::npos && Last >= Old) {
+						Send__(Last + 1);
+					}
+					//A line longer than a record cannot be kept whole anyway.
+					const size_t Largest = Capacity() / 4 - 8;
+					if (Line__.size() > Largest) {
+						Send__(Line__.size() - Line__.size() % Largest);
+					}
+					return Count;
+				}
+				Int__ overflow(Int__ Character) override {
+					if (!Traits::eq_int_type(Character, Traits::eof())) {
+						const CharT Value = Traits::to_char_type(Character);
+						xsputn(&Value, 1);
+					}
+					return Traits::not_eof(Character);
+				}
+				int sync() override {
+					Send__(Line__.size());
+					return 0;
+				}
+
+			public:
+				RingBuffer__(std::string const& Name, size_t Capacity) : SharedRingDetail::Mapping(Name, Capacity) {}
+				~RingBuffer__() override {
+					Send__(Line__.size());
+				}
+
+				size_t Waits() const {
+					return Waits__;
+				}
+		};
+
+		/**
+		 * @brief The buffer of the stream.
+		 */
+		RingBuffer__ Ring__;
+
+	public:
+		SharedRing(SharedRing const&) = delete;
+		SharedRing& operator=(SharedRing const&) = delete;
+
+		/**
+		 * @brief Opens the ring in the shared memory object `Name`, creating it if needed.
+		 * @param Name The name of the object, starting with `/`.
+		 * @param Capacity The size in bytes of the ring, if it is created. It must be at least 64 bytes and below 2 GiB.
+		 * @throw std::runtime_error If `Capacity` is out of range.
+		 * @throw std::system_error If the object cannot be opened or mapped.
+		 */
+		explicit SharedRing(std::string const& Name, size_t Capacity = 1 << 22);
+
+		/**
+		 * @brief The number of times a write found the ring full and waited for the reader.
+		 */
+		size_t FullWaits() const;
+};
+
+/**
+ * @brief Drains a ring written by SharedRing.
+ *
+ * @details Only one reader may drain a ring at a time. Records are handed out in the order their space was reserved, and their space is zeroed and freed once handed out.
+ */
+class SharedRingReader : public SharedRingDetail::Mapping {
+	public:
+		/**
+		 * @brief Opens the ring in the shared memory object `Name`, creating it if needed.
+		 * @param Capacity The size in bytes of the ring if it is created, which must match what the writers pass. An existing ring keeps the capacity in its header.
+		 * @throw std::runtime_error If `Capacity` is out of range, see SharedRing(std::string const&, size_t).
+		 * @throw std::system_error If the object cannot be opened or mapped.
+		 */
+		explicit SharedRingReader(std::string const& Name, size_t Capacity = 1 << 22) : SharedRingDetail::Mapping(Name, Capacity) {}
+
+		/**
+		 * @brief Hands every record written so far to `Sink`, as `Sink(const char* Data, size_t Size)`, and frees it.
+		 *
+		 * @details Stops at the first record reserved but not written yet.
+		 * @return The number of bytes handed out.
+		 */
+		template<typename Function> size_t Drain(Function&& Sink) {
+			const uint64_t Capacity = Header__->Capacity;
+			uint64_t Read = Header__->Read.load(std::memory_order_relaxed);
+			size_t Total = 0;
+			while (true) {
+				const uint64_t Offset = Read % Capacity;
+				const uint32_t Word = Word__(Offset).load(std::memory_order_acquire);
+				if (!Word) {
+					break;
+				}
+				uint64_t Length = Word & ~SharedRingDetail::Padding;
+				if (!(Word & SharedRingDetail::Padding)) {
+					Sink(static_cast<const char*>(Ring__ + Offset + 8), size_t(Length));
+					Total += Length;
+					Length = 8 + ((Length + 7) & ~uint64_t(7));
+				}
+				//Writers only store the length words, so everything freed must read as zero again.
+				std::memset(Ring__ + Offset, 0, Length);
+				Read += Length;
+				Header__->Read.store(Read, std::memory_order_release);
+			}
+			return Total;
+		}
+};
+
+//
+//CONSTRUCTORS
+//
+template<typename CharT, typename Traits>
+SharedRing<CharT, Traits> ::SharedRing(std::string const& Name, size_t Capacity) : std::basic_ostream<CharT, Traits>(nullptr), Ring__(Name, Capacity) {
+	this->init(&Ring__);
+}
+
+//
+//STATISTICS
+//
+template<typename CharT, typename Traits>
+size_t SharedRing<CharT, Traits> ::FullWaits() const {
+	return Ring__.Waits();
+}
+
+#endif
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file
+ * @brief Drains a SharedRing to a file, or to the standard output, until interrupted.
+ *
+ * @details Usage: `SharedRingReader Name [File [Capacity]]`. A ring which already exists is read with the capacity stored in its header; `Capacity`, 4 MiB by default, is only the size in bytes of the ring created if the reader starts before any writer, so it must match the capacity the writers pass. `-` as `File` is the standard output. On `SIGINT` or `SIGTERM` the ring is drained one last time before exiting. The reader exits with 1 if the ring cannot be opened or the output cannot be written.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "SharedRing.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+	volatile std::sig_atomic_t Stop = 0;
+
+	void Interrupt(int) {
+		Stop = 1;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2 || argc > 4) {
+		std::fprintf(stderr, "Usage: %s Name [File [Capacity]]\n", argv[0]);
+		return 2;
+	}
+	size_t Capacity = 1 << 22;
+	if (argc == 4) {
+		char* End = nullptr;
+		Capacity = std::strtoull(argv[3], &End, 10);
+		if (End == argv[3] || *End) {
+			std::fprintf(stderr, "%s: not a capacity in bytes\n", argv[3]);
+			return 2;
+		}
+	}
+	const bool ToFile = argc >= 3 && std::strcmp(argv[2], "-");
+	std::FILE* Output = ToFile ? std::fopen(argv[2], "ab") : stdout;
+	if (!Output) {
+		std::perror(argv[2]);
+		return 1;
+	}
+	std::signal(SIGINT, Interrupt);
+	std::signal(SIGTERM, Interrupt);
+	bool Failed = false;
+	try {
+		SharedRingReader Reader(argv[1], Capacity);
+		//Drained records are freed, so a failed write loses them: the reader stops at once.
+		auto Write = [Output, &Failed](const char* Data, size_t Size) {
+			if (!Failed && std::fwrite(Data, 1, Size, Output) != Size) {
+				Failed = true;
+			}
+		};
+		while (!Stop && !Failed) {
+			if (Reader.Drain(Write)) {
+				Failed = Failed || std::fflush(Output);
+			}
+			else {
+				usleep(1000);
+			}
+		}
+		if (!Failed) {
+			Reader.Drain(Write);
+		}
+	}
+	catch (std::exception const& Error) {
+		std::fprintf(stderr, "%s\n", Error.what());
+		return 1;
+	}
+	if (Failed) {
+		std::perror(ToFile ? argv[2] : "standard output");
+	}
+	return (std::fclose(Output) || Failed) ? 1 : 0;
+}
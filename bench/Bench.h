@@ -0,0 +1,209 @@
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+/**
+ * @file
+ * @brief What the benchmarks share: a stream discarding what it is given, the hardware counters of `perf_event_open` and the JSON report.
+ *
+ * @details Every case is run once to warm up and then a few times, and the fastest run is kept together with the counters read during it. The counters are opened one by one, for this thread and in user space only, and any the kernel refuses, because of `perf_event_paranoid`, a virtual machine without a PMU or another system than Linux, is reported as `null` while the time is still measured.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Bench {
+	/**
+	 * @brief A stream buffer dropping everything, so the benchmarks measure formatting rather than copying to memory or a file.
+	 */
+	template<typename CharT> class NullBuffer : public std::basic_streambuf<CharT> {
+		protected:
+			std::streamsize xsputn(const CharT*, std::streamsize Count) override {
+				return Count;
+			}
+			typename std::basic_streambuf<CharT>::int_type overflow(typename std::basic_streambuf<CharT>::int_type Character) override {
+				return std::basic_streambuf<CharT>::traits_type::not_eof(Character);
+			}
+	};
+
+	/**
+	 * @brief The hardware counters read for every case, in the order they are reported.
+	 */
+	class Counters {
+		public:
+			/**
+			 * @brief The number of counters.
+			 */
+			static constexpr size_t Count = 4;
+			/**
+			 * @brief The JSON keys of the counters, each divided by the number of elements.
+			 */
+			static constexpr const char* Names[Count] = {"instructions_per_element", "cycles_per_element", "branch_misses_per_element", "cache_misses_per_element"};
+		private:
+			int Files__[Count] = {-1, -1, -1, -1};
+		public:
+			Counters() {
+#if defined(__linux__)
+				const uint64_t Configs[Count] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+				for (size_t i = 0; i < Count; ++i) {
+					perf_event_attr Attributes;
+					std::memset(&Attributes, 0, sizeof(Attributes));
+					Attributes.size = sizeof(Attributes);
+					Attributes.type = PERF_TYPE_HARDWARE;
+					Attributes.config = Configs[i];
+					Attributes.disabled = 1;
+					Attributes.exclude_kernel = 1;
+					Attributes.exclude_hv = 1;
+					//The counters may be multiplexed, so the times they ran are read to scale them.
+					Attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+					Files__[i] = static_cast<int>(syscall(SYS_perf_event_open, &Attributes, 0, -1, -1, 0));
+				}
+#endif
+			}
+			~Counters() {
+#if defined(__linux__)
+				for (const int File : Files__) {
+					if (File >= 0) {
+						close(File);
+					}
+				}
+#endif
+			}
+			Counters(Counters const&) = delete;
+			Counters& operator=(Counters const&) = delete;
+			/**
+			 * @brief Tells if any counter could be opened.
+			 */
+			bool Any() const {
+				for (const int File : Files__) {
+					if (File >= 0) {
+						return true;
+					}
+				}
+				return false;
+			}
+			/**
+			 * @brief Zeroes and starts every counter.
+			 */
+			void Start() {
+#if defined(__linux__)
+				for (const int File : Files__) {
+					if (File >= 0) {
+						ioctl(File, PERF_EVENT_IOC_RESET, 0);
+						ioctl(File, PERF_EVENT_IOC_ENABLE, 0);
+					}
+				}
+#endif
+			}
+			/**
+			 * @brief Stops every counter and reads it into `Values`, `-1` for those which are not available.
+			 */
+			void Stop(double (&Values)[Count]) {
+				for (size_t i = 0; i < Count; ++i) {
+					Values[i] = -1;
+#if defined(__linux__)
+					uint64_t Read[3];
+					if (Files__[i] >= 0 && !ioctl(Files__[i], PERF_EVENT_IOC_DISABLE, 0) && read(Files__[i], Read, sizeof(Read)) == sizeof(Read) && Read[2]) {
+						Values[i] = double(Read[0]) * double(Read[1]) / double(Read[2]);
+					}
+#endif
+				}
+			}
+	};
+
+	/**
+	 * @brief Runs the cases of one benchmark and writes their costs per element as JSON.
+	 *
+	 * **Output:**
+	 * ```
+	 * {"benchmark": "Integers", "counters": true, "results": [
+	 *   {"case": "operator() long long", "elements": 2000000, "ns_per_element": 4.1, "instructions_per_element": 52.3, "cycles_per_element": 16.2, "branch_misses_per_element": 0.01, "cache_misses_per_element": 0.0002}
+	 * ]}
+	 * ```
+	 */
+	class Report {
+		private:
+			std::string Name__;
+			Counters Counters__;
+			std::string Results__;
+		public:
+			/**
+			 * @brief The number of timed runs of every case, the fastest one is kept.
+			 */
+			static constexpr int Runs = 5;
+
+			explicit Report(std::string Name) : Name__{std::move(Name)} {
+			}
+			/**
+			 * @brief Runs `Body`, which handles `Elements` elements, and records its costs per element.
+			 */
+			template<typename Function> void Run(const char* Case, size_t Elements, Function&& Body) {
+				Body();
+				double Best = -1;
+				double Values[Counters::Count];
+				for (int i = 0; i < Runs; ++i) {
+					double Current[Counters::Count];
+					const auto Begin = std::chrono::steady_clock::now();
+					Counters__.Start();
+					Body();
+					Counters__.Stop(Current);
+					const double Elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Begin).count();
+					if (Best < 0 || Elapsed < Best) {
+						Best = Elapsed;
+						std::copy(Current, Current + Counters::Count, Values);
+					}
+				}
+				Results__ += Results__.empty() ? "\n" : ",\n";
+				Results__ += std::string("  {\"case\": \"") + Case + "\", \"elements\": " + std::to_string(Elements) + ", \"ns_per_element\": " + Number__(Best / Elements);
+				for (size_t i = 0; i < Counters::Count; ++i) {
+					Results__ += std::string(", \"") + Counters::Names[i] + "\": " + (Values[i] < 0 ? std::string("null") : Number__(Values[i] / Elements));
+				}
+				Results__ += "}";
+				std::cerr << Name__ << ": " << Case << ": " << Number__(Best / Elements) << " ns per element\n";
+			}
+			/**
+			 * @brief Writes the report to `Path`, or to the standard output if it is `nullptr`.
+			 * @return The exit code of the benchmark.
+			 */
+			int Write(const char* Path) const {
+				std::ofstream File;
+				if (Path) {
+					File.open(Path);
+					if (!File) {
+						std::cerr << "Cannot open " << Path << '\n';
+						return 1;
+					}
+				}
+				std::ostream& Out = Path ? File : std::cout;
+				Out << "{\"benchmark\": \"" << Name__ << "\", \"counters\": " << (Counters__.Any() ? "true" : "false") << ", \"results\": [" << Results__ << "\n]}\n";
+				return Out ? 0 : 1;
+			}
+		private:
+			/**
+			 * @brief Writes `Value` with six significant digits, which JSON reads as is.
+			 */
+			static std::string Number__(double Value) {
+				char Text[32];
+				std::snprintf(Text, sizeof(Text), "%.6g", Value);
+				return Text;
+			}
+	};
+}
+
+#endif
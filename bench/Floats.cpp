@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @brief Measures the floating point paths of OutputManager: the shortest and fixed precision general notation, the fixed notation kernel, scientific notation, floats and the long doubles left to `operator<<`.
+ * @details Usage: `Floats [File]`, writing the JSON report to the standard output if no file is given.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "Bench.h"
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+	constexpr size_t Count = 1 << 20;
+	std::mt19937_64 Random(1);
+	std::uniform_real_distribution<double> Mantissa(-1, 1);
+	std::vector<double> Doubles(Count);
+	std::vector<float> Floats(Count);
+	std::vector<long double> LongDoubles(Count);
+	for (size_t i = 0; i < Count; ++i) {
+		Doubles[i] = Mantissa(Random) * double(1 << (Random() % 24));
+		Floats[i] = float(Doubles[i]);
+		LongDoubles[i] = Doubles[i];
+	}
+	Bench::NullBuffer<char> Sink;
+	std::ostream Stream(&Sink);
+	Bench::Report Report("Floats");
+
+	//Mode and precision of every case, see OutputManager::SetFloatMode(int).
+	struct Case {
+		const char* Name;
+		int Mode;
+		size_t Precision;
+	};
+	for (const Case Current : {Case{"general precision 6", 0, 6}, Case{"general precision 17", 0, 17}, Case{"fixed precision 2", 1, 2}, Case{"fixed precision 12", 1, 12}, Case{"scientific precision 6", -1, 6}}) {
+		Report.Run((std::string("FormatToColumns double ") + Current.Name).c_str(), Count, [&]() {
+			OutputManager<std::ostream, std::string> Manager(Stream);
+			Manager.SetFloatMode(Current.Mode);
+			Manager.SetPrecision(Current.Precision);
+			Manager.FormatToColumns(Doubles.begin(), Doubles.end());
+		});
+	}
+	Report.Run("operator() three doubles per line", Count / 3 * 3, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		for (size_t i = 0; i + 3 <= Count; i += 3) {
+			Manager(Doubles[i], Doubles[i + 1], Doubles[i + 2]);
+		}
+	});
+	Report.Run("PrintRange float", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.PrintRange(Floats.begin(), Floats.end());
+	});
+	Report.Run("PrintRange long double", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.PrintRange(LongDoubles.begin(), LongDoubles.end());
+	});
+
+	return Report.Write(argc > 1 ? argv[1] : nullptr);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file
+ * @brief Measures the hexadecimal kernels one by one on a large buffer, and HexDump with the kernel bound for this CPU and with the scalar one.
+ * @details Usage: `HexDump [File]`, writing the JSON report to the standard output if no file is given. Elements are bytes.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "OutputManagerSimd.h"
+#include "Bench.h"
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+	constexpr size_t Count = 1 << 24;
+	std::mt19937_64 Random(1);
+	std::vector<unsigned char> Bytes(Count);
+	for (auto& Byte : Bytes) {
+		Byte = static_cast<unsigned char>(Random());
+	}
+	std::vector<char> Digits(2 * Count);
+	Bench::NullBuffer<char> Sink;
+	std::ostream Stream(&Sink);
+	Bench::Report Report("HexDump");
+
+	struct Kernel {
+		const char* Name;
+		OutputManagerDetail::HexKernel Function;
+	};
+	std::vector<Kernel> Kernels{{"HexBytesScalar", OutputManagerDetail::HexBytesScalar}};
+#if defined(OUTPUTMANAGER_DISPATCH)
+	if (OutputManagerDetail::Cpu().Ssse3) {
+		Kernels.push_back({"HexBytesSsse3", OutputManagerDetail::HexBytesSsse3});
+	}
+	if (OutputManagerDetail::Cpu().Avx2) {
+		Kernels.push_back({"HexBytesAvx2", OutputManagerDetail::HexBytesAvx2});
+	}
+	if (OutputManagerDetail::Cpu().Avx512bw) {
+		Kernels.push_back({"HexBytesAvx512", OutputManagerDetail::HexBytesAvx512});
+	}
+#endif
+	for (const Kernel Current : Kernels) {
+		Report.Run(Current.Name, Count, [&]() {
+			Current.Function(Digits.data(), Bytes.data(), Count, false);
+		});
+	}
+	const OutputManagerDetail::HexKernel Bound = OutputManagerDetail::HexBytesKernel;
+	Report.Run("HexDump", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.HexDump(Bytes.data(), Count);
+	});
+	OutputManagerDetail::HexBytesKernel = OutputManagerDetail::HexBytesScalar;
+	Report.Run("HexDump with HexBytesScalar", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.HexDump(Bytes.data(), Count);
+	});
+	OutputManagerDetail::HexBytesKernel = Bound;
+
+	return Report.Write(argc > 1 ? argv[1] : nullptr);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file
+ * @brief Measures the integer paths of OutputManager: whole lines, bounded columns and ranges in decimal, other bases, grouped and as sizes.
+ * @details Usage: `Integers [File]`, writing the JSON report to the standard output if no file is given.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "Bench.h"
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+	constexpr size_t Count = 1 << 20;
+	std::mt19937_64 Random(1);
+	std::vector<long long> Wide(Count);
+	std::vector<unsigned> Narrow(Count);
+	std::vector<short> Short(Count);
+	for (size_t i = 0; i < Count; ++i) {
+		//Every length of number, not only the longest.
+		Wide[i] = static_cast<long long>(Random()) >> (Random() % 64);
+		Narrow[i] = static_cast<unsigned>(Random() >> (Random() % 64));
+		Short[i] = static_cast<short>(Random());
+	}
+	Bench::NullBuffer<char> Sink;
+	std::ostream Stream(&Sink);
+	Bench::Report Report("Integers");
+
+	Report.Run("operator() long long", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		for (const long long Value : Wide) {
+			Manager(Value);
+		}
+	});
+	Report.Run("operator() four long longs per line", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		for (size_t i = 0; i < Count; i += 4) {
+			Manager(Wide[i], Wide[i + 1], Wide[i + 2], Wide[i + 3]);
+		}
+	});
+	Report.Run("FormatToColumns long long, unsigned, short", 3 * Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.FormatToColumns(Wide.begin(), Wide.end(), Narrow.begin(), Short.begin());
+	});
+	Report.Run("PrintRange unsigned", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.PrintRange(Narrow.begin(), Narrow.end());
+	});
+	Report.Run("FormatToColumns hexadecimal", 2 * Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.SetBase(16);
+		Manager.FormatToColumns(Wide.begin(), Wide.end(), Narrow.begin());
+	});
+	Report.Run("FormatToColumns grouped", 2 * Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.SetGrouping(0);
+		Manager.SetGrouping(1);
+		Manager.FormatToColumns(Wide.begin(), Wide.end(), Narrow.begin());
+	});
+	Report.Run("FormatToColumns sizes", 2 * Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.SetUnits(0, 1);
+		Manager.SetUnits(1, -1);
+		Manager.FormatToColumns(Wide.begin(), Wide.end(), Narrow.begin());
+	});
+
+	return Report.Write(argc > 1 ? argv[1] : nullptr);
+}
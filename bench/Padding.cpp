@@ -0,0 +1,52 @@
+/**
+ * @file
+ * @brief Measures padding to a width: numbers and strings aligned left, right and internally, with the default and another fill character, against no width at all.
+ * @details Usage: `Padding [File]`, writing the JSON report to the standard output if no file is given.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "Bench.h"
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+	constexpr size_t Count = 1 << 20;
+	std::mt19937_64 Random(1);
+	std::vector<int> Integers(Count);
+	std::vector<std::string> Strings(Count);
+	for (size_t i = 0; i < Count; ++i) {
+		Integers[i] = static_cast<int>(Random()) >> (Random() % 32);
+		Strings[i].assign(Random() % 16, 'x');
+	}
+	Bench::NullBuffer<char> Sink;
+	std::ostream Stream(&Sink);
+	Bench::Report Report("Padding");
+
+	struct Case {
+		const char* Name;
+		size_t Width;
+		int Alignment;
+		char Fill;
+	};
+	for (const Case Current : {Case{"no width", 0, 1, ' '}, Case{"width 24 left", 24, 1, ' '}, Case{"width 24 right", 24, -1, ' '}, Case{"width 24 internal", 24, 0, ' '}, Case{"width 24 right, fill 0", 24, -1, '0'}, Case{"width 80 right", 80, -1, ' '}}) {
+		Report.Run((std::string("FormatToColumns int, ") + Current.Name).c_str(), Count, [&]() {
+			OutputManager<std::ostream, std::string> Manager(Stream);
+			Manager.SetWidth(Current.Width);
+			Manager.SetAlignment(Current.Alignment);
+			Manager.SetFill(Current.Fill);
+			Manager.FormatToColumns(Integers.begin(), Integers.end());
+		});
+		Report.Run((std::string("FormatToColumns string, ") + Current.Name).c_str(), Count, [&]() {
+			OutputManager<std::ostream, std::string> Manager(Stream);
+			Manager.SetWidth(Current.Width);
+			Manager.SetAlignment(Current.Alignment);
+			Manager.SetFill(Current.Fill);
+			Manager.FormatToColumns(Strings.begin(), Strings.end());
+		});
+	}
+
+	return Report.Write(argc > 1 ? argv[1] : nullptr);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file
+ * @brief Measures the text paths of OutputManager: strings, C strings and characters copied to a narrow stream, and wide strings to a wide one, short and long.
+ * @details Usage: `Strings [File]`, writing the JSON report to the standard output if no file is given.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "Bench.h"
+#include <random>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+	constexpr size_t Count = 1 << 20;
+	std::mt19937_64 Random(1);
+	std::vector<std::string> Short(Count), Long(Count / 8);
+	std::vector<std::wstring> WideShort(Count);
+	std::vector<const char*> Pointers(Count);
+	std::vector<char> Characters(Count);
+	for (size_t i = 0; i < Count; ++i) {
+		Short[i].assign(Random() % 16, char('a' + i % 26));
+		WideShort[i].assign(Short[i].begin(), Short[i].end());
+		Pointers[i] = Short[i].c_str();
+		Characters[i] = char('a' + i % 26);
+	}
+	for (auto& Text : Long) {
+		Text.assign(100 + Random() % 400, 'y');
+	}
+	Bench::NullBuffer<char> Sink;
+	Bench::NullBuffer<wchar_t> WideSink;
+	std::ostream Stream(&Sink);
+	std::wostream WideStream(&WideSink);
+	Bench::Report Report("Strings");
+
+	Report.Run("PrintRange string up to 15 characters", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.PrintRange(Short.begin(), Short.end());
+	});
+	Report.Run("PrintRange string of 100 to 500 characters", Long.size(), [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.PrintRange(Long.begin(), Long.end());
+	});
+	Report.Run("PrintRange C string", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.PrintRange(Pointers.begin(), Pointers.end());
+	});
+	Report.Run("PrintRange char", Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.PrintRange(Characters.begin(), Characters.end());
+	});
+	Report.Run("FormatToColumns string, char", 2 * Count, [&]() {
+		OutputManager<std::ostream, std::string> Manager(Stream);
+		Manager.FormatToColumns(Short.begin(), Short.end(), Characters.begin());
+	});
+	Report.Run("PrintRange wstring to a wide stream", Count, [&]() {
+		OutputManager<std::wostream> Manager(WideStream);
+		Manager.PrintRange(WideShort.begin(), WideShort.end());
+	});
+
+	return Report.Write(argc > 1 ? argv[1] : nullptr);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @brief Fuzzes DeferredLogDecoder: the input is decoded as a log itself, and also picks settings and lines for a valid log, which must decode to what OutputManager prints, and then bytes to flip in it and a length to cut it to. A corrupted log may only throw `std::runtime_error`.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "DeferredLog.h"
+#include "Fuzz.h"
+#include <sstream>
+#include <string>
+#include <stdexcept>
+
+namespace {
+	/**
+	 * @brief Decodes `Log` with a new OutputManager writing `CharT`.
+	 * @return The text, or an empty string if the log was rejected.
+	 */
+	template<typename CharT> std::basic_string<CharT> Decode(std::string const& Log) {
+		std::istringstream Binary(Log);
+		std::basic_ostringstream<CharT> Text;
+		OutputManager<std::basic_ostream<CharT>, std::basic_string<CharT>> Manager(Text);
+		try {
+			DeferredLogDecoder().Decode(Binary, Manager);
+		}
+		catch (std::runtime_error const&) {
+			return {};
+		}
+		return Text.str();
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* Data, size_t Size) {
+	const std::string Raw(reinterpret_cast<const char*>(Data), Size);
+	Decode<char>(Raw);
+	Decode<wchar_t>(Raw);
+
+	Fuzz::Bytes In(Data, Size);
+	std::ostringstream Expected;
+	OutputManager<std::ostream, std::string> Manager(Expected, ",", "\n");
+	Manager.SetAlignment(In.Take<uint8_t>() % 3 - 1);
+	Manager.SetFloatMode(In.Take<uint8_t>() % 3 - 1);
+	Manager.SetPrecision(In.Take<uint8_t>() % 18);
+	Manager.SetWidth(In.Take<uint8_t>() % 20);
+	std::stringstream Binary;
+	{
+		DeferredLog Log(Binary, Manager);
+		for (size_t Lines = In.Take<uint8_t>() % 16; Lines; --Lines) {
+			const long long Integer = In.Take<long long>();
+			const double Real = In.Take<double>();
+			const size_t Length = In.Take<uint8_t>() % 16;
+			const std::string Text(Length, char('a' + In.Take<uint8_t>() % 26));
+			const float Single = In.Take<float>();
+			switch (In.Take<uint8_t>() % 4) {
+				case 0:
+					Log(Integer);
+					Manager(Integer);
+					break;
+				case 1:
+					Log(Real, Text);
+					Manager(Real, Text);
+					break;
+				case 2:
+					Log(Integer, Real, Text, Single);
+					Manager(Integer, Real, Text, Single);
+					break;
+				default:
+					Log();
+					Manager();
+			}
+		}
+	}
+	const std::string Valid = Binary.str();
+	if (Decode<char>(Valid) != Expected.str()) {
+		Fuzz::Fail("a valid log decodes to what OutputManager prints");
+	}
+
+	//The rest of the input flips bytes of the valid log, then cuts it short.
+	std::string Corrupted = Valid;
+	while (In.Left() > 3 && !Corrupted.empty()) {
+		const size_t Position = In.Take<uint16_t>() % Corrupted.size();
+		Corrupted[Position] = char(Corrupted[Position] ^ In.Take<uint8_t>());
+	}
+	Decode<char>(Corrupted);
+	Decode<wchar_t>(Corrupted);
+	Corrupted.resize(Corrupted.empty() ? 0 : In.Take<uint16_t>() % Corrupted.size());
+	Decode<char>(Corrupted);
+	return 0;
+}
@@ -0,0 +1,107 @@
+#ifndef FUZZ_FUZZ_H
+#define FUZZ_FUZZ_H
+
+/**
+ * @file
+ * @brief What the fuzz targets share: a reader of the input bytes, the failure report and, unless libFuzzer drives the target, a `main` replaying inputs.
+ *
+ * @details Every file in `fuzz` defines `LLVMFuzzerTestOneInput`. Built with `clang++ -fsanitize=fuzzer -DOUTPUTMANAGER_LIBFUZZER` it is a libFuzzer target. Built without that macro it is a plain program: with arguments it replays the files they name, without any it runs a fixed number of inputs of random bytes from fixed seeds, so it runs like the tests. A failed check prints what failed and aborts, and a random input that failed is first saved to `fuzz-failure.bin` so it can be replayed.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* Data, size_t Size);
+
+namespace Fuzz {
+	/**
+	 * @brief The random input being run by `main`, saved if it fails, `nullptr` when replaying files or under libFuzzer.
+	 */
+	inline std::vector<uint8_t> const* Current = nullptr;
+
+	/**
+	 * @brief Reports `What`, saves the random input being run if there is one, and aborts, which is what libFuzzer expects of a failed check.
+	 */
+	[[noreturn]] inline void Fail(const char* What) {
+		std::cerr << "FAILED: " << What << '\n';
+		if (Current) {
+			std::ofstream("fuzz-failure.bin", std::ios::binary).write(reinterpret_cast<const char*>(Current->data()), Current->size());
+			std::cerr << "The input was saved to fuzz-failure.bin\n";
+		}
+		std::abort();
+	}
+
+	/**
+	 * @brief Hands out the input bytes as values, zeros once they run out.
+	 */
+	class Bytes {
+		private:
+			const uint8_t* Data__;
+			size_t Size__;
+		public:
+			Bytes(const uint8_t* Data, size_t Size) : Data__{Data}, Size__{Size} {
+			}
+			/**
+			 * @brief The number of bytes not taken yet.
+			 */
+			size_t Left() const {
+				return Size__;
+			}
+			/**
+			 * @brief Takes the next `sizeof(T)` bytes as a `T`, padded with zeros at the end of the input.
+			 */
+			template<typename T> T Take() {
+				unsigned char Raw[sizeof(T)] = {};
+				const size_t Count = std::min(sizeof(T), Size__);
+				if (Count) {
+					std::memcpy(Raw, Data__, Count);
+				}
+				Data__ += Count;
+				Size__ -= Count;
+				T Value;
+				std::memcpy(&Value, Raw, sizeof(T));
+				return Value;
+			}
+	};
+}
+
+#if !defined(OUTPUTMANAGER_LIBFUZZER)
+int main(int argc, char** argv) {
+	if (argc > 1) {
+		for (int i = 1; i < argc; ++i) {
+			std::ifstream File(argv[i], std::ios::binary);
+			if (!File) {
+				std::cerr << "Cannot open " << argv[i] << '\n';
+				return 1;
+			}
+			const std::vector<uint8_t> Input{std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()};
+			LLVMFuzzerTestOneInput(Input.data(), Input.size());
+		}
+		return 0;
+	}
+	//Mostly short inputs, which reach the most branches per byte, and some long ones.
+	for (uint64_t Run = 0; Run < 3000; ++Run) {
+		std::mt19937_64 Random(Run);
+		std::vector<uint8_t> Input(Run % 10 ? Random() % 256 : Random() % 16384);
+		for (auto& Byte : Input) {
+			Byte = static_cast<uint8_t>(Random());
+		}
+		Fuzz::Current = &Input;
+		LLVMFuzzerTestOneInput(Input.data(), Input.size());
+	}
+	return 0;
+}
+#endif
+
+#endif
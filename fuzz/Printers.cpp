@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @brief Fuzzes the printers of OutputManager: the input picks the alignment, float mode, precision and width, then values of every kind, which must print exactly as `operator<<` with `std::setw` prints them. The input itself is hex dumped and checked against a dump built byte by byte.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "OutputManagerSimd.h"
+#include "Fuzz.h"
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+	/**
+	 * @brief The dump HexDump prints with the default settings, built one byte at a time with `std::hex`.
+	 */
+	std::wstring Dump(const uint8_t* Bytes, size_t Size, size_t BytesPerLine, size_t Group) {
+		std::wostringstream Expected;
+		Expected << std::hex << std::setfill(L'0');
+		for (size_t Offset = 0; Offset < Size; Offset += BytesPerLine) {
+			const size_t Count = std::min(BytesPerLine, Size - Offset);
+			Expected << std::setw(8) << Offset << L": ";
+			for (size_t i = 0; i < BytesPerLine; ++i) {
+				if (i && i % Group == 0) {
+					Expected << L' ';
+				}
+				if (i < Count) {
+					Expected << std::setw(2) << unsigned(Bytes[Offset + i]);
+				}
+				else {
+					Expected << L"  ";
+				}
+			}
+			Expected << L"  ";
+			for (size_t i = 0; i < Count; ++i) {
+				const uint8_t Byte = Bytes[Offset + i];
+				Expected << (Byte >= 0x20 && Byte < 0x7F ? wchar_t(Byte) : L'.');
+			}
+			Expected << L'\n';
+		}
+		return Expected.str();
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* Data, size_t Size) {
+	Fuzz::Bytes In(Data, Size);
+	const int Alignment = In.Take<uint8_t>() % 3 - 1;
+	const int FloatMode = In.Take<uint8_t>() % 3 - 1;
+	const int Precision = In.Take<uint8_t>() % 25;
+	const size_t Width = In.Take<uint8_t>() % 41;
+	std::wostringstream Printed, Expected;
+	OutputManager<std::wostream> Manager(Printed, L", ", L";\n");
+	Manager.SetAlignment(Alignment);
+	Manager.SetFloatMode(FloatMode);
+	Manager.SetPrecision(Precision);
+	Manager.SetWidth(Width);
+	Expected.copyfmt(Printed);
+	std::vector<double> Reals;
+	std::vector<long long> Integers;
+	//Every value goes on a line of its own and in a column of bounded or unbounded values.
+	auto Line = [&](auto const& Value) {
+		Manager(Value, Value, 7);
+		Expected << std::setw(Width) << Value << L", " << std::setw(Width) << Value << L", " << std::setw(Width) << 7 << L";\n";
+	};
+	while (In.Left()) {
+		switch (In.Take<uint8_t>() % 6) {
+			case 0:
+				Integers.push_back(In.Take<long long>());
+				Line(Integers.back());
+				break;
+			case 1:
+				Line(In.Take<unsigned>());
+				break;
+			case 2:
+				Line(In.Take<short>());
+				break;
+			case 3:
+				Reals.push_back(In.Take<double>());
+				Line(Reals.back());
+				break;
+			case 4:
+				Line(In.Take<float>());
+				break;
+			default: {
+				std::wstring Text(In.Take<uint8_t>() % 32, L' ');
+				for (auto& Character : Text) {
+					Character = wchar_t(In.Take<uint16_t>());
+				}
+				Line(Text);
+			}
+		}
+	}
+	Manager.PrintRange(Reals.begin(), Reals.end());
+	for (const double Value : Reals) {
+		Expected << std::setw(Width) << Value << L", ";
+	}
+	Expected << L";\n";
+	Integers.resize(Reals.size());
+	Manager.FormatToColumns(Reals.begin(), Reals.end(), Integers.begin());
+	for (size_t i = 0; i < Reals.size(); ++i) {
+		Expected << std::setw(Width) << Reals[i] << L", " << std::setw(Width) << Integers[i] << L";\n";
+	}
+	if (Printed.str() != Expected.str()) {
+		Fuzz::Fail("values print as with operator<<");
+	}
+
+	const size_t BytesPerLine = Size ? Data[0] % 40 + 1 : 16;
+	const size_t Group = Size > 1 ? Data[1] % BytesPerLine + 1 : 2;
+	std::wostringstream Dumped;
+	OutputManager<std::wostream> Dumper(Dumped);
+	Dumper.HexDump(Data, Size, BytesPerLine, Group);
+	if (Dumped.str() != Dump(Data, Size, BytesPerLine, Group)) {
+		Fuzz::Fail("hex dumps match a dump built byte by byte");
+	}
+	return 0;
+}
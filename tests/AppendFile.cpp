@@ -0,0 +1,128 @@
+/**
+ * @file
+ * @brief Checks that lines appended by several processes through AppendFile never tear, and that a failed write loses nothing.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "AppendFile.h"
+#include "Check.h"
+#include <fstream>
+#include <locale>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+namespace {
+	/**
+	 * @brief The text of line `Line` of process `Process`, sometimes longer than `PIPE_BUF`.
+	 */
+	std::string Text(int Process, int Line) {
+		return std::string(Line % 97 ? Line % 50 : 3 * PIPE_BUF, char('a' + Process));
+	}
+
+	/**
+	 * @brief Appends lines from several processes at once and checks every line of the file.
+	 */
+	template<typename CharT> void Processes(std::string const& Path, size_t BatchSize) {
+		constexpr int Count = 4, Lines = 5000;
+		unlink(Path.c_str());
+		for (int Process = 0; Process < Count; ++Process) {
+			if (!fork()) {
+				{
+					AppendFile<CharT> File(Path, BatchSize);
+					OutputManager<std::basic_ostream<CharT>, std::basic_string<CharT>> Manager(File);
+					for (int Line = 0; Line < Lines; ++Line) {
+						const std::string Narrow = Text(Process, Line);
+						Manager(Process, Line, std::basic_string<CharT>(Narrow.begin(), Narrow.end()));
+					}
+				}
+				_exit(0);
+			}
+		}
+		for (int Process = 0; Process < Count; ++Process) {
+			wait(nullptr);
+		}
+		std::ifstream In(Path);
+		std::vector<int> Next(Count, 0);
+		bool Whole = true;
+		for (std::string Line; std::getline(In, Line);) {
+			const int Process = std::atoi(Line.c_str());
+			const int Number = std::atoi(Line.c_str() + Line.find(' ') + 1);
+			if (Process < 0 || Process >= Count || Number != Next[Process] || Line != std::to_string(Process) + ' ' + std::to_string(Number) + ' ' + Text(Process, Number)) {
+				Whole = false;
+				break;
+			}
+			++Next[Process];
+		}
+		Check(Whole, "lines from several processes do not tear");
+		Check(Next == std::vector<int>(Count, Lines), "every line of every process is in the file");
+		unlink(Path.c_str());
+	}
+}
+
+int main() {
+	const std::string Path = "/tmp/AppendFile." + std::to_string(getpid());
+	Processes<char>(Path, PIPE_BUF);
+	Processes<char>(Path, 1 << 16);
+	Processes<wchar_t>(Path, PIPE_BUF);
+	Processes<wchar_t>(Path, 1 << 16);
+
+	//Wide text is encoded by the locale of the stream, lines split across batches included.
+	std::locale Locale;
+	if (Utf8(Locale)) {
+		unlink(Path.c_str());
+		{
+			AppendFile<wchar_t> File(Path, 16);
+			File.imbue(Locale);
+			OutputManager<std::wostream> Manager(File);
+			for (int Line = 0; Line < 100; ++Line) {
+				Manager(Line, L"h\u00E9llo \u20AC \U0001D11E");
+			}
+		}
+		std::ifstream In(Path);
+		bool Same = true;
+		int Count = 0;
+		for (std::string Line; std::getline(In, Line); ++Count) {
+			Same = Same && Line == std::to_string(Count) + " h\xC3\xA9llo \xE2\x82\xAC \xF0\x9D\x84\x9E";
+		}
+		Check(Same && Count == 100, "wide text outside ASCII is written in the encoding of the locale");
+		unlink(Path.c_str());
+	}
+
+	//A full non-blocking pipe fails the write, which is retried once there is room.
+	int Pipe[2];
+	if (pipe(Pipe) < 0) {
+		return 1;
+	}
+	fcntl(Pipe[1], F_SETFL, fcntl(Pipe[1], F_GETFL) | O_NONBLOCK);
+	fcntl(Pipe[0], F_SETFL, fcntl(Pipe[0], F_GETFL) | O_NONBLOCK);
+	size_t Filled = 0;
+	for (char Byte = 'x'; write(Pipe[1], &Byte, 1) == 1; ++Filled) {
+	}
+	{
+		AppendFile<char> File(Pipe[1]);
+		OutputManager<std::ostream, std::string> Manager(File);
+		Manager("kept", 1);
+		File.flush();
+		Check(File.bad(), "a failed write sets badbit");
+		char Drain[4096];
+		for (ssize_t Count; Filled && (Count = read(Pipe[0], Drain, sizeof(Drain))) > 0; Filled -= Count) {
+		}
+		File.clear();
+		File.flush();
+		Check(File.good(), "the write succeeds once there is room");
+		std::string Out(64, '\0');
+		const ssize_t Count = read(Pipe[0], &Out[0], Out.size());
+		Out.resize(Count > 0 ? Count : 0);
+		Check(Out == "kept 1\n", "the text of the failed write is written on retry");
+	}
+	close(Pipe[0]);
+	close(Pipe[1]);
+
+	return Failures != 0;
+}
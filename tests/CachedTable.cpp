@@ -0,0 +1,123 @@
+/**
+ * @file
+ * @brief Checks that CachedTable prints what OutputManager prints, and formats rows again whenever their values change.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "CachedTable.h"
+#include "Check.h"
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <locale>
+#include <string>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+int main() {
+	std::ostringstream Expected, Stream;
+	OutputManager<std::ostream, std::string> Reference(Expected), Manager(Stream);
+	Reference.SetWidth(5);
+	Manager.SetWidth(5);
+	CachedTable Table(Manager);
+	for (int Row = 0; Row < 100; ++Row) {
+		Table.Set(Row, Row, Row * 0.5, "row");
+		Reference(Row, Row * 0.5, "row");
+	}
+	Table.Emit();
+	Check(Stream.str() == Expected.str(), "the table prints the rows as OutputManager does");
+
+	Check(!Table.Set(3, 3, 1.5, "row"), "equal values are not formatted again");
+	Check(!Table.Set(3, 3, 1.5, std::string("row")), "strings are compared by content");
+	Check(Table.Set(3, 3, 1.5, "ROW"), "a changed string is formatted again");
+
+	//These values have the same hash.
+	std::ostringstream Colliding;
+	OutputManager<std::ostream, std::string> Other(Colliding);
+	CachedTable Small(Other);
+	Small.Set(0, 0, 1);
+	Check(Small.Set(0, 1, 190), "values with the same hash are still compared");
+	Small.Emit();
+	Check(Colliding.str() == "1 190\n", "the row holds the new values");
+	Check(Small.Set(0, 1L, 190L), "values of other types are formatted again");
+
+	//Zeros of different sign compare equal but print differently.
+	std::ostringstream Zeros, ZerosExpected;
+	OutputManager<std::ostream, std::string> ZerosManager(Zeros), ZerosReference(ZerosExpected);
+	CachedTable ZerosTable(ZerosManager);
+	ZerosTable.Set(0, 1, 0.0);
+	Check(ZerosTable.Set(0, 1, -0.0), "a zero changing sign is formatted again");
+	Check(!ZerosTable.Set(0, 1, -0.0), "a zero keeping its sign is not formatted again");
+	ZerosTable.Emit();
+	ZerosReference(1, -0.0);
+	Check(Zeros.str() == ZerosExpected.str(), "the row holds the zero with its sign");
+
+	//Stamped rows get the time they are written, not the one they were formatted at.
+	{
+		std::ostringstream StampedStream;
+		OutputManager<std::ostream, std::string> StampedManager(StampedStream);
+		CachedTable StampedTable(StampedManager);
+		StampedTable.Set(0, 1, 2);
+		StampedManager.SetTimestamp("T%S", 0);
+		StampedTable.Set(1, 3, 4);
+		StampedTable.Resize(3);
+		StampedTable.Emit();
+		const std::string Text = StampedStream.str();
+		Check(Text.size() == 16 && Text[0] == 'T' && Text.substr(3, 5) == " 1 2\n" && Text[8] == 'T' && Text.substr(11) == " 3 4\n", "rows formatted before or after the timestamp was set are stamped when written");
+	}
+
+	//A wide table keeps narrow strings by content too.
+	std::wostringstream WideStream;
+	OutputManager<> Wide(WideStream);
+	CachedTable<> WideTable(Wide);
+	char Buffer[] = "old";
+	WideTable.Set(0, 1, static_cast<const char*>(Buffer));
+	Buffer[0] = 'n';
+	Buffer[1] = 'e';
+	Buffer[2] = 'w';
+	Check(WideTable.Set(0, 1, static_cast<const char*>(Buffer)), "a narrow string changed in place is formatted again in a wide table");
+	Check(!WideTable.Set(0, 1, "new"), "narrow strings are compared by content in a wide table");
+	Check(WideTable.Set(1, 2, "lit"), "a narrow literal is kept by a wide table");
+	Check(!WideTable.Set(1, 2, "lit") && !WideTable.Set(1, 2, static_cast<const char*>("lit")), "narrow literals are compared by content in a wide table");
+	Check(WideTable.Set(2, 3, static_cast<const char*>(nullptr)) && !WideTable.Set(2, 3, static_cast<const char*>(nullptr)), "null strings are kept");
+	WideTable.Set(2, 3, L"wide");
+	WideTable.Emit();
+	Check(WideStream.str() == L"1 new\n2 lit\n3 wide\n", "the wide table holds the new values");
+
+#if defined(__unix__) || defined(__APPLE__)
+	//Patch() rewrites changed rows in place, at positions counted in bytes of the encoding of the stream.
+	std::locale Locale;
+	if (Utf8(Locale)) {
+		const std::string Path = "/tmp/CachedTable." + std::to_string(getpid());
+		std::wofstream File(Path);
+		File.imbue(Locale);
+		OutputManager<> Writer(File);
+		Writer.SetWidth(5);
+		CachedTable<> Table(Writer);
+		for (int Row = 0; Row < 4; ++Row) {
+			Table.Set(Row, Row, L"\u20ACuro");
+		}
+		Table.Emit();
+		File.flush();
+		const int Descriptor = open(Path.c_str(), O_WRONLY);
+		Table.Set(2, 7, L"\u00A3\u00A3");
+		Check(Table.Patch(Descriptor), "a wide row keeping its length in bytes is patched");
+		const auto Read = [&Path]() {
+			std::ifstream In(Path, std::ios::binary);
+			return std::string((std::istreambuf_iterator<char>(In)), std::istreambuf_iterator<char>());
+		};
+		const std::string Euro = "     \xE2\x82\xACuro \n";
+		const std::string Expected = '0' + Euro + '1' + Euro + "7     \xC2\xA3\xC2\xA3   \n" + '3' + Euro;
+		Check(Read() == Expected, "the patched row is written in the encoding of the stream, in place");
+		Table.Set(1, 1, L"\u00E9euro");
+		Check(!Table.Patch(Descriptor) && Read() == Expected, "a wide row keeping its characters but not its bytes is refused");
+		close(Descriptor);
+		unlink(Path.c_str());
+	}
+#endif
+
+	return Failures != 0;
+}
@@ -0,0 +1,49 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+/**
+ * @file
+ * @brief The checks shared by the tests: every failed check is reported on `std::cerr` and counted, and each test returns `Failures != 0` from `main`.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include <iostream>
+#include <locale>
+#include <stdexcept>
+
+namespace {
+	/**
+	 * @brief The number of failed checks so far.
+	 */
+	int Failures = 0;
+
+	/**
+	 * @brief Reports `What` and counts a failure if `Condition` is `false`.
+	 */
+	void Check(bool Condition, const char* What) {
+		if (!Condition) {
+			std::cerr << "FAILED: " << What << '\n';
+			++Failures;
+		}
+	}
+
+	/**
+	 * @brief Sets `Locale` to a UTF-8 locale.
+	 * @return `false` if the system has none, in which case the checks of text outside ASCII are skipped.
+	 */
+	[[maybe_unused]] bool Utf8(std::locale& Locale) {
+		for (const char* Name : {"C.UTF-8", "C.utf8", "en_US.UTF-8"}) {
+			try {
+				Locale = std::locale(Name);
+				return true;
+			}
+			catch (std::runtime_error const&) {
+			}
+		}
+		std::cerr << "SKIPPED: no UTF-8 locale\n";
+		return false;
+	}
+}
+
+#endif
@@ -0,0 +1,372 @@
+/**
+ * @file
+ * @brief Checks that DeferredLog prints what OutputManager prints straight away, when rendering in the background and when decoding a binary log, and that errors and full logs are handled.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "DeferredLog.h"
+#include "Check.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <limits>
+
+namespace {
+	constexpr int Threads = 4, Lines = 20000;
+
+	/**
+	 * @brief Logs the lines of thread `Thread` with `Log`, which is a DeferredLog or an OutputManager.
+	 */
+	template<typename Logger> void Print(Logger& Log, int Thread) {
+		for (int Line = 0; Line < Lines; ++Line) {
+			Log(Thread, Line, "at", Line * 0.001 - 3, std::string(Line % 13, char('a' + Thread)), Line % 2 == 0, (unsigned char)('A' + Line % 26));
+		}
+	}
+
+	/**
+	 * @brief The lines of `Text`.
+	 */
+	std::vector<std::string> Split(std::string const& Text) {
+		std::vector<std::string> Result;
+		std::istringstream In(Text);
+		for (std::string Line; std::getline(In, Line);) {
+			Result.push_back(Line);
+		}
+		return Result;
+	}
+
+	/**
+	 * @brief Checks that `Text` holds the lines of every thread, those of each thread in order.
+	 */
+	void Compare(std::string const& Text, std::string const& Expected, const char* What) {
+		std::vector<std::string> Got = Split(Text), Want = Split(Expected);
+		std::vector<std::vector<std::string>> PerThread(Threads);
+		for (std::string const& Line : Got) {
+			const size_t Thread = size_t(Line[0] - '0');
+			if (Thread < PerThread.size()) {
+				PerThread[Thread].push_back(Line);
+			}
+		}
+		bool Ordered = true;
+		for (int Thread = 0; Thread < Threads; ++Thread) {
+			Ordered = Ordered && std::equal(PerThread[Thread].begin(), PerThread[Thread].end(), Want.begin() + Thread * Lines, Want.begin() + (Thread + 1) * Lines);
+		}
+		Check(Got.size() == Want.size() && Ordered, What);
+	}
+
+	/**
+	 * @brief A string buffer that can be read while the background thread writes to it.
+	 */
+	class LockedBuffer : public std::stringbuf {
+		private:
+			std::recursive_mutex Lock;
+
+		protected:
+			std::streamsize xsputn(const char* Text, std::streamsize Count) override {
+				std::lock_guard<std::recursive_mutex> Guard(Lock);
+				return std::stringbuf::xsputn(Text, Count);
+			}
+			int_type overflow(int_type Character) override {
+				std::lock_guard<std::recursive_mutex> Guard(Lock);
+				return std::stringbuf::overflow(Character);
+			}
+
+		public:
+			std::string Snapshot() {
+				std::lock_guard<std::recursive_mutex> Guard(Lock);
+				return str();
+			}
+	};
+
+	/**
+	 * @brief Logs from every thread at once.
+	 */
+	template<typename Logger> void FromThreads(Logger& Log) {
+		std::vector<std::thread> Pool;
+		for (int Thread = 0; Thread < Threads; ++Thread) {
+			Pool.emplace_back([&Log, Thread]() {
+				Print(Log, Thread);
+			});
+		}
+		for (auto& Worker : Pool) {
+			Worker.join();
+		}
+	}
+}
+
+int main() {
+	std::ostringstream Immediate;
+	{
+		OutputManager<std::ostream, std::string> Manager(Immediate);
+		Manager.SetSeparator(", ");
+		Manager.SetPrecision(3);
+		for (int Thread = 0; Thread < Threads; ++Thread) {
+			Print(Manager, Thread);
+		}
+	}
+
+	//Rendered in the background, from several threads at once.
+	std::ostringstream Rendered;
+	{
+		OutputManager<std::ostream, std::string> Manager(Rendered);
+		Manager.SetSeparator(", ");
+		Manager.SetPrecision(3);
+		DeferredLog Log(Manager, 1 << 12);
+		FromThreads(Log);
+	}
+	Compare(Rendered.str(), Immediate.str(), "lines rendered in the background are the ones printed straight away");
+
+	//Written to a binary log and decoded later, with the same settings.
+	std::stringstream Binary;
+	{
+		DeferredLog Log(Binary, 1 << 12);
+		FromThreads(Log);
+	}
+	std::ostringstream Decoded;
+	{
+		OutputManager<std::ostream, std::string> Manager(Decoded);
+		Manager.SetSeparator(", ");
+		Manager.SetPrecision(3);
+		DeferredLogDecoder().Decode(Binary, Manager);
+	}
+	Compare(Decoded.str(), Immediate.str(), "lines decoded from a binary log are the ones printed straight away");
+
+	//Written with the settings of an OutputManager, which a default one gets back when decoding.
+	{
+		std::ostringstream Direct;
+		std::stringstream Stored;
+		OutputManager<std::ostream, std::string> Manager(Direct);
+		Manager.SetSeparator(" | ");
+		Manager.SetEndOfLine(";\n");
+		Manager.SetPrecision(2);
+		Manager.SetWidth(8);
+		Manager.SetAlignment(-1);
+		Manager.SetFill('.');
+		Manager.SetGrouping(0, '\'');
+		Manager.SetUnits(2, 1);
+		{
+			DeferredLog Log(Stored, Manager);
+			Log(1234567, 3.14159, 2048u, "x");
+			Log(-42, 1e-3, 5000000ul, "yz");
+		}
+		Manager(1234567, 3.14159, 2048u, "x");
+		Manager(-42, 1e-3, 5000000ul, "yz");
+		std::ostringstream Plain;
+		OutputManager<std::ostream, std::string> Decoder(Plain);
+		DeferredLogDecoder().Decode(Stored, Decoder);
+		Check(Plain.str() == Direct.str(), "a binary log decodes with the settings stored in it");
+	}
+	//Settings out of range are skipped and reported, the lines are still decoded.
+	{
+		std::ostringstream Ignored;
+		std::stringstream Stored;
+		OutputManager<std::ostream, std::string> Manager(Ignored);
+		Manager.SetWidth(size_t(1) << 40);
+		{
+			DeferredLog Log(Stored, Manager);
+			Log(1, "x");
+		}
+		std::ostringstream Plain;
+		OutputManager<std::ostream, std::string> Decoder(Plain);
+		bool Thrown = false;
+		try {
+			DeferredLogDecoder().Decode(Stored, Decoder);
+		}
+		catch (std::runtime_error const&) {
+			Thrown = true;
+		}
+		Check(Thrown && Plain.str() == "1 x\n", "settings out of range are reported and skipped");
+	}
+	//The padding of a long double is not copied into the log.
+	{
+		std::stringstream Stored;
+		long double Padded;
+		std::memset(static_cast<void*>(&Padded), 0xFF, sizeof(Padded));
+		Padded = 1.5L;
+		{
+			DeferredLog Log(Stored);
+			Log(Padded);
+		}
+		const std::string Log = Stored.str();
+		const size_t Value = Log.size() - sizeof(long double);
+		Check(std::numeric_limits<long double>::digits != 64 || Log.find_first_not_of('\0', Value + 10) == std::string::npos, "the padding of a long double is stored as zeros");
+	}
+
+	//A corrupted log is reported, not allocated from.
+	{
+		const auto Corrupted = [](std::string const& Records) {
+			std::ostringstream Text;
+			OutputManager<std::ostream, std::string> Manager(Text);
+			try {
+				DeferredLogDecoder().Render(Records.data(), Records.data() + Records.size(), Manager);
+			}
+			catch (std::runtime_error const&) {
+				return true;
+			}
+			return false;
+		};
+		const auto Word = [](uint32_t Value) {
+			return std::string(reinterpret_cast<const char*>(&Value), sizeof(Value));
+		};
+		const uint32_t Huge = 0x7FFFFFF0;
+		Check(Corrupted(Word(Huge | DeferredLogDetail::Definition) + '\0'), "a call site id out of range is reported");
+		Check(Corrupted(Word(DeferredLogDetail::Definition) + '\1' + char(DeferredLogDetail::Text) + Word(0) + Word(Huge) + "abc"), "a string longer than the log is reported");
+	}
+
+	//A wide string cannot be rendered to a narrow stream: Flush() and the destructor rethrow, and later lines are kept whole.
+	std::ostringstream Failing;
+	OutputManager<std::ostream, std::string> Narrow(Failing);
+	{
+		DeferredLog Log(Narrow);
+		Log(1, L"wide");
+		bool Thrown = false;
+		try {
+			Log.Flush();
+		}
+		catch (std::runtime_error const&) {
+			Thrown = true;
+		}
+		Check(Thrown, "Flush() rethrows what rendering threw");
+		Log(2, "narrow");
+		Log.Flush();
+		Check(Failing.str() == "2 narrow\n", "a failed line leaves nothing behind");
+	}
+	//The lines and call sites after a failed line in the same buffer are kept.
+	{
+		std::ostringstream Rest;
+		OutputManager<std::ostream, std::string> Manager(Rest);
+		DeferredLog Log(Manager);
+		Log(1, L"wide");
+		Log(2.5f, "after");
+		Log(short(3), 4u);
+		bool Thrown = false;
+		try {
+			Log.Flush();
+		}
+		catch (std::runtime_error const&) {
+			Thrown = true;
+		}
+		Log(short(5), 6u);
+		Log.Flush();
+		Check(Thrown && Rest.str() == "2.5 after\n3 4\n5 6\n", "a failed line does not lose the lines and call sites after it");
+	}
+	bool Thrown = false;
+	{
+		DeferredLog Log(Narrow);
+		Log(L"wide");
+		try {
+			Log.Close();
+		}
+		catch (std::runtime_error const&) {
+			Thrown = true;
+		}
+	}
+	Check(Thrown, "Close() rethrows what rendering threw");
+	//The destructor drops it instead.
+	{
+		DeferredLog Log(Narrow);
+		Log(L"wide");
+	}
+
+	//Flush() returns while another thread keeps logging, once the lines logged before it are out.
+	{
+		LockedBuffer Text;
+		std::ostream Busy(&Text);
+		OutputManager<std::ostream, std::string> Manager(Busy);
+		DeferredLog Log(Manager);
+		std::atomic<bool> Stop{false};
+		std::thread Chatter([&]() {
+			while (!Stop) {
+				Log(0, "chatter");
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+			}
+		});
+		bool Found = true;
+		for (int Round = 0; Round < 20; ++Round) {
+			Log(1, Round);
+			Log.Flush();
+			Found = Found && ("\n" + Text.Snapshot()).find("\n1 " + std::to_string(Round) + "\n") != std::string::npos;
+		}
+		Stop = true;
+		Chatter.join();
+		Check(Found, "Flush() returns while another thread logs, with the lines logged before it written");
+	}
+
+	//A lone line wakes the background thread, which renders it without a Flush().
+	{
+		LockedBuffer Text;
+		std::ostream Quiet(&Text);
+		OutputManager<std::ostream, std::string> Manager(Quiet);
+		DeferredLog Log(Manager);
+		Log(7, "alone");
+		const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (Text.Snapshot().empty() && std::chrono::steady_clock::now() < Deadline) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		Check(Text.Snapshot() == "7 alone\n", "a lone line is rendered without a Flush()");
+	}
+
+	//OUTPUTMANAGER_LOG gives every call site its own id, and prints what operator() prints.
+	{
+		auto First = []() {};
+		auto Second = []() {};
+		const uint32_t Shared = DeferredLogDetail::Site<int, double>();
+		const uint32_t Own = DeferredLogDetail::Site<decltype(First), int, double>();
+		Check(Own != Shared && Own != DeferredLogDetail::Site<decltype(Second), int, double>() && Shared == DeferredLogDetail::Site<int, double>(), "call sites logged through a tag have ids of their own");
+		std::ostringstream Text;
+		std::stringstream Stored;
+		{
+			OutputManager<std::ostream, std::string> Manager(Text);
+			DeferredLog Log(Manager);
+			for (int i = 0; i < 3; ++i) {
+				OUTPUTMANAGER_LOG(Log, i, 0.5 * i);
+				OUTPUTMANAGER_LOG(Log, i, "twice");
+				Log(i, 0.5 * i);
+			}
+		}
+		{
+			DeferredLog Log(Stored);
+			OUTPUTMANAGER_LOG(Log, 1, 2.5);
+			OUTPUTMANAGER_LOG(Log, 3, 4.5);
+		}
+		std::ostringstream Decoded;
+		OutputManager<std::ostream, std::string> Manager(Decoded);
+		DeferredLogDecoder().Decode(Stored, Manager);
+		Check(Text.str() == "0 0\n0 twice\n0 0\n1 0.5\n1 twice\n1 0.5\n2 1\n2 twice\n2 1\n" && Decoded.str() == "1 2.5\n3 4.5\n", "call sites with their own ids render and decode like the others");
+	}
+
+	//A full log waits, or drops lines and counts them.
+	for (bool Drop : {false, true}) {
+		std::ostringstream Bounded;
+		OutputManager<std::ostream, std::string> Manager(Bounded);
+		Manager.SetSeparator(", ");
+		Manager.SetPrecision(3);
+		size_t Dropped = 0;
+		{
+			DeferredLog Log(Manager);
+			Log.SetCapacity(256, Drop);
+			FromThreads(Log);
+			Log.Flush();
+			Dropped = Log.Dropped();
+		}
+		const size_t Count = Split(Bounded.str()).size();
+		if (Drop) {
+			Check(Dropped > 0 && Count + Dropped == size_t(Threads) * Lines, "a full log drops lines and counts them");
+		}
+		else {
+			Check(Dropped == 0, "a full log drops nothing when waiting");
+			Compare(Bounded.str(), Immediate.str(), "a full log waits for room and loses nothing");
+		}
+	}
+
+	return Failures != 0;
+}
@@ -0,0 +1,482 @@
+/**
+ * @file
+ * @brief Checks that the printers of OutputManager write exactly what `operator<<` with `std::setw` writes, for many numbers, strings and formatting states, and that the parallel, batched, capped and SIMD paths write what the plain ones write.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "OutputManagerSimd.h"
+#include "OutputManagerParallel.h"
+#include "InputManager.h"
+#include "OrderedOutput.h"
+#include "Check.h"
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <thread>
+#include <locale>
+
+namespace {
+	/**
+	 * @brief Digits grouped by three with an apostrophe, as SetGrouping(size_t, typename OutType::char_type) groups them.
+	 */
+	struct Thousands : std::numpunct<wchar_t> {
+		wchar_t do_thousands_sep() const override {
+			return L'\'';
+		}
+		std::string do_grouping() const override {
+			return "\3";
+		}
+	};
+
+	/**
+	 * @brief The size FormatUnits() writes for `Value`, scaled by hand and written with `operator<<`.
+	 */
+	template<typename T> std::wstring Size(T Value, int Units) {
+		const wchar_t* Iec[] = {L"B", L"KiB", L"MiB", L"GiB", L"TiB", L"PiB", L"EiB"};
+		const wchar_t* Si[] = {L"B", L"kB", L"MB", L"GB", L"TB", L"PB", L"EB"};
+		const double Base = Units > 0 ? 1024 : 1000;
+		double Scaled = std::fabs(double(Value));
+		int Unit = 0;
+		for (; Unit < 6 && Scaled >= Base; ++Unit) {
+			Scaled /= Base;
+		}
+		if (Unit && Unit < 6 && Scaled >= Base - 0.05) {
+			Scaled /= Base;
+			++Unit;
+		}
+		std::wostringstream Text;
+		if (std::is_integral_v<T> && !Unit) {
+			Text << Value;
+		}
+		else {
+			Text << (std::signbit(double(Value)) ? L"-" : L"") << std::fixed << std::setprecision(1) << Scaled;
+		}
+		Text << L' ' << (Units > 0 ? Iec : Si)[Unit];
+		return Text.str();
+	}
+
+	/**
+	 * @brief Prints `Values` with PrintRange, FormatToColumns and operator(), and the same with `operator<<` after copying the formatting state.
+	 * @param Setup Changes the formatting state of the stream before printing.
+	 */
+	template<typename T, typename Function> void Compare(std::vector<T> const& Values, int Alignment, int Precision, int FloatMode, size_t Width, Function&& Setup, const char* What) {
+		std::wostringstream Printed, Expected;
+		OutputManager<std::wostream> Manager(Printed, L", ", L";\n");
+		Manager.SetAlignment(Alignment);
+		Manager.SetPrecision(Precision);
+		Manager.SetFloatMode(FloatMode);
+		Manager.SetWidth(Width);
+		Setup(Printed);
+		Expected.copyfmt(Printed);
+		auto Field = [&](auto const& Value) {
+			Expected << std::setw(Width) << Value;
+		};
+		Manager.PrintRange(Values.begin(), Values.end());
+		for (auto const& Value : Values) {
+			Field(Value);
+			Expected << L", ";
+		}
+		Expected << L";\n";
+		Manager.FormatToColumns(Values.begin(), Values.end(), Values.begin());
+		for (auto const& Value : Values) {
+			Field(Value);
+			Expected << L", ";
+			Field(Value);
+			Expected << L";\n";
+		}
+		for (auto const& Value : Values) {
+			Manager(Value, 7, Value);
+			Field(Value);
+			Expected << L", ";
+			Field(7);
+			Expected << L", ";
+			Field(Value);
+			Expected << L";\n";
+		}
+		Check(Printed.str() == Expected.str(), What);
+	}
+
+	/**
+	 * @brief The dump HexDump prints, built one byte at a time with `std::hex`.
+	 */
+	std::wstring Dump(std::vector<unsigned char> const& Bytes, size_t BytesPerLine, size_t Group, bool Upper, std::wstring const& Separator) {
+		std::wostringstream Expected;
+		Expected << std::hex << std::setfill(L'0');
+		if (Upper) {
+			Expected << std::uppercase;
+		}
+		for (size_t Offset = 0; Offset < Bytes.size(); Offset += BytesPerLine) {
+			const size_t Count = std::min(BytesPerLine, Bytes.size() - Offset);
+			Expected << std::setw(8) << Offset << L':' << Separator;
+			for (size_t i = 0; i < BytesPerLine; ++i) {
+				if (i && i % Group == 0) {
+					Expected << (i < Count ? Separator : std::wstring(Separator.size(), L' '));
+				}
+				if (i < Count) {
+					Expected << std::setw(2) << unsigned(Bytes[Offset + i]);
+				}
+				else {
+					Expected << L"  ";
+				}
+			}
+			Expected << Separator << Separator;
+			for (size_t i = 0; i < Count; ++i) {
+				const unsigned char Byte = Bytes[Offset + i];
+				Expected << (Byte >= 0x20 && Byte < 0x7F ? wchar_t(Byte) : L'.');
+			}
+			Expected << L'\n';
+		}
+		return Expected.str();
+	}
+}
+
+int main() {
+	std::mt19937_64 Random(42);
+	std::vector<double> Doubles;
+	std::vector<float> Floats;
+	std::vector<long double> LongDoubles;
+	std::vector<long long> Integers;
+	std::vector<unsigned> Unsigned;
+	std::vector<short> Shorts;
+	std::vector<std::wstring> Strings;
+	for (int i = 0; i < 300; ++i) {
+		double Value = std::ldexp(double(Random()) / 1e19 - 0.9, int(Random() % 80) - 40);
+		if (i % 7 == 0) {
+			Value = std::round(Value * 1000) / 1000;
+		}
+		if (i % 11 == 0) {
+			Value = int64_t(Random() % 100000) / 8.0 - 5000;
+		}
+		Doubles.push_back(Value);
+		Floats.push_back(float(Value));
+		LongDoubles.push_back(Value);
+		Integers.push_back((long long)Random() >> (Random() % 64));
+		Unsigned.push_back(unsigned(Random()));
+		Shorts.push_back(short(Random()));
+		Strings.push_back(std::wstring(Random() % 12, wchar_t(L'a' + i % 26)));
+	}
+	//Ties, powers of ten and values that round differently in binary.
+	Doubles.insert(Doubles.end(), {0.0, -0.0, 1e300, -1e-300, 0.5, 1.5, 2.5, 0.125, 0.005, 1.005, 2.675, 1e22, 123456789.0, NAN, INFINITY, -INFINITY});
+	Integers.insert(Integers.end(), {0, -1, INT64_MIN, INT64_MAX});
+
+	auto Plain = [](std::wostream&) {};
+	for (int Alignment : {-1, 0, 1}) {
+		for (int FloatMode : {-1, 0, 1}) {
+			for (int Precision : {0, 1, 2, 3, 6, 10, 17}) {
+				for (size_t Width : {0, 3, 12, 30}) {
+					Compare(Doubles, Alignment, Precision, FloatMode, Width, Plain, "doubles print as with operator<<");
+					Compare(Floats, Alignment, Precision, FloatMode, Width, Plain, "floats print as with operator<<");
+					Compare(LongDoubles, Alignment, Precision, FloatMode, Width, Plain, "long doubles print as with operator<<");
+				}
+			}
+		}
+		for (size_t Width : {0, 3, 12, 30}) {
+			Compare(Integers, Alignment, 6, 0, Width, Plain, "long longs print as with operator<<");
+			Compare(Unsigned, Alignment, 6, 0, Width, Plain, "unsigned ints print as with operator<<");
+			Compare(Shorts, Alignment, 6, 0, Width, Plain, "shorts print as with operator<<");
+			Compare(Strings, Alignment, 6, 0, Width, Plain, "strings print as with operator<<");
+		}
+	}
+
+	//States the built-in printers leave to operator<<.
+	auto Signed = [](std::wostream& Stream) {
+		Stream << std::showpos << std::uppercase;
+	};
+	auto Hexadecimal = [](std::wostream& Stream) {
+		Stream << std::hex << std::showbase;
+	};
+	Compare(Doubles, 1, 6, 1, 12, Signed, "doubles with showpos and uppercase print as with operator<<");
+	Compare(Integers, 1, 6, 0, 12, Signed, "integers with showpos print as with operator<<");
+	Compare(Integers, -1, 6, 0, 20, Hexadecimal, "hexadecimal integers print as with operator<<");
+
+	//Hex dumps of every length up to a few blocks, whatever the kernel picked for this CPU.
+	{
+		std::vector<unsigned char> Bytes;
+		for (int Size = 0; Size < 300; Size += Size < 70 ? 1 : 37) {
+			Bytes.resize(Size);
+			for (auto& Byte : Bytes) {
+				Byte = static_cast<unsigned char>(Random());
+			}
+			for (size_t BytesPerLine : {1, 7, 16, 32, 40}) {
+				for (size_t Group : {1, 2, 5, 16}) {
+					std::wostringstream Printed;
+					OutputManager<std::wostream> Manager(Printed);
+					Manager.HexDump(Bytes.data(), Bytes.size(), BytesPerLine, Group);
+					Printed << std::uppercase;
+					Manager.HexDump(Bytes.data(), Bytes.size(), BytesPerLine, Group);
+					Check(Printed.str() == Dump(Bytes, BytesPerLine, Group, false, L" ") + Dump(Bytes, BytesPerLine, Group, true, L" "), "hex dumps match a dump built byte by byte");
+				}
+			}
+		}
+	}
+
+	//Lines printed from several threads come out in iteration order, within the memory cap or spilled beyond it.
+	for (const int Overflow : {-1, 0, 1}) {
+		std::wostringstream Printed, Expected;
+		OutputManager<std::wostream> Manager(Printed), Reference(Expected);
+		Manager.SetWidth(6);
+		Reference.SetWidth(6);
+		if (Overflow >= 0) {
+			Manager.SetMemoryCap(4096, Overflow);
+		}
+		constexpr size_t Iterations = 3000, Threads = 4;
+		{
+			OrderedOutput Lines(Manager, Iterations);
+			std::vector<std::thread> Workers;
+			for (size_t Thread = 0; Thread < Threads; ++Thread) {
+				Workers.emplace_back([&, Thread]() {
+					for (size_t i = Thread * Iterations / Threads; i < (Thread + 1) * Iterations / Threads; ++i) {
+						Lines(i, i, Doubles[i % Doubles.size()], Strings[i % Strings.size()]);
+						if (i % 3 == 0) {
+							Lines(i, std::hex, i);
+						}
+						Lines.Done(i);
+					}
+				});
+			}
+			for (auto& Worker : Workers) {
+				Worker.join();
+			}
+		}
+		for (size_t i = 0; i < Iterations; ++i) {
+			Reference(i, Doubles[i % Doubles.size()], Strings[i % Strings.size()]);
+			if (i % 3 == 0) {
+				Reference(std::hex, i);
+				Expected << std::dec;
+			}
+		}
+		Check(Printed.str() == Expected.str(), "ordered output prints the lines of every iteration in order");
+		Check(Overflow < 0 || Manager.PeakMemoryFootprint() < 4 * 4096, "ordered output keeps its slots within the memory cap");
+	}
+
+	//Manipulators among the elements apply to the rest of the line, as with operator<<.
+	{
+		std::wostringstream Printed, Expected;
+		OutputManager<std::wostream> Manager(Printed);
+		Manager(std::hex, 255, 3.5);
+		Manager(std::dec, 255, std::setprecision(2), 3.14159, std::showpos, 7);
+		Expected << std::hex << L' ' << 255 << L' ' << 3.5 << L'\n';
+		Expected << std::dec << L' ' << 255 << L' ' << std::setprecision(2) << L' ' << 3.14159 << L' ' << std::showpos << L' ' << 7 << L'\n';
+		Check(Printed.str() == Expected.str(), "manipulators apply to the elements after them");
+	}
+
+	//A width no buffer can hold is refused before anything is written.
+	{
+		std::wostringstream Printed;
+		OutputManager<std::wostream> Manager(Printed);
+		Manager.SetWidth(size_t(1) << 63);
+		auto Refused = [&](auto&& Print) {
+			try {
+				Print();
+			}
+			catch (std::bad_alloc const&) {
+				return true;
+			}
+			return false;
+		};
+		Check(Refused([&]() {Manager.FormatToColumns(Shorts.begin(), Shorts.end(), Unsigned.begin());}), "bounded columns wider than memory are refused");
+		Check(Refused([&]() {Manager.PrintRange(Integers.begin(), Integers.end());}), "bounded ranges wider than memory are refused");
+		Check(Refused([&]() {Manager.HexDump("Salmon", 6);}), "hex dumps wider than memory are refused");
+		Check(Printed.str().empty(), "nothing is written for refused widths");
+	}
+
+	//Separators fixed at compile time print the same text and take no space.
+	{
+		static_assert(sizeof(OutputManager<std::wostream, CommaSeparated<>>) + 2 * sizeof(std::wstring) == sizeof(OutputManager<std::wostream>), "static separators are not stored");
+		std::wostringstream Printed, Expected;
+		OutputManager<std::wostream, CommaSeparated<>> Static(Printed);
+		OutputManager<std::wostream> Dynamic(Expected, L",", L"\n");
+		Static(1, 2.5, L"Salmon");
+		Dynamic(1, 2.5, L"Salmon");
+		Static.PrintRange(Integers.begin(), Integers.end());
+		Dynamic.PrintRange(Integers.begin(), Integers.end());
+		Static.FormatToRows(Shorts.begin(), Shorts.end(), Unsigned.begin());
+		Dynamic.FormatToRows(Shorts.begin(), Shorts.end(), Unsigned.begin());
+		Check(Printed.str() == Expected.str(), "static separators print what runtime ones print");
+	}
+
+	//Rows printed in parallel match FormatToRows, whatever the number of workers and the memory cap, with rows split in many chunks.
+	{
+		std::vector<long long> ManyIntegers;
+		std::vector<double> ManyDoubles;
+		std::vector<std::wstring> ManyStrings;
+		for (size_t i = 0; i < 20000; ++i) {
+			ManyIntegers.push_back(Integers[i % Integers.size()]);
+			ManyDoubles.push_back(Doubles[(3 * i) % Doubles.size()]);
+			ManyStrings.push_back(Strings[(7 * i) % Strings.size()]);
+		}
+		for (const size_t Workers : {1, 2, 3, 8}) {
+			for (const int Overflow : {-1, 0, 1}) {
+				std::wostringstream Printed, Expected;
+				OutputManager<std::wostream> Manager(Printed, L", ", L";\n"), Reference(Expected, L", ", L";\n");
+				for (auto* Target : {&Manager, &Reference}) {
+					Target->SetWidth(9);
+					Target->SetPrecision(4);
+					Target->SetGrouping(1);
+				}
+				Manager.SetWorkers(Workers);
+				if (Overflow >= 0) {
+					Manager.SetMemoryCap(4096, Overflow);
+				}
+				Manager.ParallelFormatToRows(ManyIntegers.begin(), ManyIntegers.end(), ManyDoubles.begin(), ManyStrings.begin());
+				Reference.FormatToRows(ManyIntegers.begin(), ManyIntegers.end(), ManyDoubles.begin(), ManyStrings.begin());
+				Manager.ParallelFormatToRows(Shorts.begin(), Shorts.begin());
+				Reference.FormatToRows(Shorts.begin(), Shorts.begin());
+				Check(Printed.str() == Expected.str(), "rows printed in parallel match FormatToRows");
+			}
+		}
+	}
+
+	//Grouped columns print as operator<< with a locale grouping by three, integers and floating point numbers in every mode.
+	{
+		const std::locale Grouped(std::locale::classic(), new Thousands);
+		for (int Alignment : {-1, 0, 1}) {
+			for (int FloatMode : {0, 1}) {
+				for (int Precision : {0, 2, 10}) {
+					std::wostringstream Printed, Expected;
+					OutputManager<std::wostream> Manager(Printed);
+					Manager.SetAlignment(Alignment);
+					Manager.SetFloatMode(FloatMode);
+					Manager.SetPrecision(Precision);
+					Manager.SetWidth(16);
+					Manager.SetGrouping(1, L'\'');
+					Manager.SetGrouping(2, L'\'');
+					Expected.copyfmt(Printed);
+					auto Field = [&](auto const& Value, bool Group) {
+						std::wostringstream Text;
+						Text.copyfmt(Printed);
+						if (Group) {
+							Text.imbue(Grouped);
+						}
+						Text << std::setw(16) << Value;
+						return Text.str();
+					};
+					for (size_t i = 0; i < Doubles.size(); ++i) {
+						const long long Integer = Integers[i % Integers.size()];
+						Manager(Integer, Integer, Doubles[i]);
+						Expected << Field(Integer, false) << L' ' << Field(Integer, true) << L' ' << Field(Doubles[i], true) << L'\n';
+					}
+					Check(Printed.str() == Expected.str(), "grouped columns print as operator<< with a grouping locale");
+				}
+			}
+		}
+	}
+
+	//Size columns print the value scaled to its unit with one decimal, as operator<< with std::fixed does.
+	for (int Units : {-1, 1}) {
+		std::wostringstream Printed, Expected;
+		OutputManager<std::wostream> Manager(Printed);
+		Manager.SetWidth(12);
+		Manager.SetUnits(0, Units);
+		Manager.SetUnits(1, Units);
+		Expected.copyfmt(Printed);
+		std::vector<long long> Sizes(Integers);
+		Sizes.insert(Sizes.end(), {999, 1000, 1023, 1024, 1048575, 1048576, 999949, 999950, -2048});
+		for (size_t i = 0; i < Sizes.size(); ++i) {
+			const double Real = Doubles[i % Doubles.size()];
+			Manager(Sizes[i], Real);
+			Expected << std::setw(12) << Size(Sizes[i], Units) << L' ' << std::setw(12) << Size(Real, Units) << L'\n';
+		}
+		Check(Printed.str() == Expected.str(), "size columns print as scaled by hand");
+	}
+
+	//A small memory cap, kept or spilled, and a LineBatch write what the plain printers write.
+	for (const int Overflow : {-1, 0, 1}) {
+		std::wostringstream Printed, Expected;
+		OutputManager<std::wostream> Manager(Printed), Reference(Expected);
+		Manager.SetWidth(7);
+		Reference.SetWidth(7);
+		if (Overflow >= 0) {
+			Manager.SetMemoryCap(256, Overflow);
+		}
+		std::vector<unsigned char> Bytes(5000);
+		for (auto& Byte : Bytes) {
+			Byte = static_cast<unsigned char>(Random());
+		}
+		for (auto* Target : {&Manager, &Reference}) {
+			Target->PrintRange(Doubles.begin(), Doubles.end());
+			Target->PrintRange(Strings.begin(), Strings.end());
+			Target->FormatToColumns(Integers.begin(), Integers.end(), Shorts.begin());
+			Target->FormatToColumns(Floats.begin(), Floats.end(), Strings.begin());
+			Target->FormatToRows(Unsigned.begin(), Unsigned.end(), Shorts.begin());
+			Target->HexDump(Bytes.data(), Bytes.size());
+		}
+		{
+			auto Lines = Manager.Batch(64);
+			for (size_t i = 0; i < Doubles.size(); ++i) {
+				Lines(Integers[i % Integers.size()], Doubles[i], Strings[i % Strings.size()]);
+				Reference(Integers[i % Integers.size()], Doubles[i], Strings[i % Strings.size()]);
+			}
+		}
+		Check(Printed.str() == Expected.str(), "capped printers and batches write what plain printers write");
+	}
+
+	//Every SIMD kernel this CPU runs writes what its scalar version writes, at every offset and length.
+	{
+		std::vector<unsigned char> Bytes(300);
+		std::string Text(300, ' ');
+		for (size_t i = 0; i < Bytes.size(); ++i) {
+			Bytes[i] = static_cast<unsigned char>(Random());
+			Text[i] = "abc,;\n"[Random() % (i % 50 < 40 ? 3 : 6)];
+		}
+		std::vector<OutputManagerDetail::HexKernel> HexKernels{OutputManagerDetail::HexBytesKernel.load()};
+		std::vector<const char* (*)(const char*, const char*, char, char, char)> FindKernels;
+#if defined(OUTPUTMANAGER_DISPATCH)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("ssse3")) {
+			HexKernels.push_back(OutputManagerDetail::HexBytesSsse3);
+		}
+		if (__builtin_cpu_supports("avx2")) {
+			HexKernels.push_back(OutputManagerDetail::HexBytesAvx2);
+			FindKernels.push_back(InputManagerDetail::FindAnyAvx2);
+		}
+		if (__builtin_cpu_supports("sse2")) {
+			FindKernels.push_back(InputManagerDetail::FindAnySse2);
+		}
+		if (__builtin_cpu_supports("avx512bw")) {
+			HexKernels.push_back(OutputManagerDetail::HexBytesAvx512);
+			FindKernels.push_back(InputManagerDetail::FindAnyAvx512);
+		}
+#endif
+		bool Same = true;
+		for (size_t Begin = 0; Begin < 40; ++Begin) {
+			for (size_t Count = 0; Begin + Count <= Bytes.size(); Count += Count < 80 ? 1 : 23) {
+				for (const bool Upper : {false, true}) {
+					std::string Expected(2 * Count, ' ');
+					OutputManagerDetail::HexBytesScalar(Expected.data(), Bytes.data() + Begin, Count, Upper);
+					for (auto Kernel : HexKernels) {
+						std::string Written(2 * Count, ' ');
+						Kernel(Written.data(), Bytes.data() + Begin, Count, Upper);
+						Same = Same && Written == Expected;
+					}
+				}
+				const char* First = Text.data() + Begin;
+				const char* Last = First + Count;
+				for (auto Kernel : FindKernels) {
+					Same = Same && Kernel(First, Last, ',', ';', '\n') == InputManagerDetail::FindAnyScalar(First, Last, ',', ';', '\n');
+				}
+			}
+		}
+		Check(Same, "SIMD kernels write what the scalar kernels write");
+		//The whole printer too, with the bound kernel and with the scalar one.
+		std::wostringstream Printed, Expected;
+		OutputManager<std::wostream> Manager(Printed), Reference(Expected);
+		Manager.HexDump(Bytes.data(), Bytes.size(), 40, 8);
+		const OutputManagerDetail::HexKernel Bound = OutputManagerDetail::HexBytesKernel;
+		Check(Bound == OutputManagerDetail::PickHexBytes(), "the first hex dump binds the kernel picked for this CPU");
+		OutputManagerDetail::HexBytesKernel = OutputManagerDetail::HexBytesScalar;
+		Reference.HexDump(Bytes.data(), Bytes.size(), 40, 8);
+		OutputManagerDetail::HexBytesKernel = Bound;
+		Check(Printed.str() == Expected.str(), "hex dumps with the SIMD kernel match those with the scalar kernel");
+	}
+
+	return Failures != 0;
+}
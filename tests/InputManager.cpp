@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @brief Checks that InputManager reads back what OutputManager prints, serially and in parallel, with narrow and wide separators, appending to columns of any size.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "InputManager.h"
+#include "Check.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <cstdio>
+
+namespace {
+	/**
+	 * @brief Prints the columns with `Separator` and reads them back with `Reader`, serially and in parallel.
+	 */
+	template<typename StringType> void RoundTrip(InputManager<StringType>& Reader, const char* Separator, std::vector<int> const& Integers, std::vector<double> const& Reals, std::vector<std::string> const& Words) {
+		std::ostringstream Stream;
+		Stream.precision(17);
+		OutputManager<std::ostream, std::string> Writer(Stream);
+		Writer.SetSeparator(Separator);
+		Writer.FormatToColumns(Integers.begin(), Integers.end(), Reals.begin(), Words.begin());
+		const std::string Text = Stream.str();
+		std::vector<int> I;
+		std::vector<double> R;
+		std::vector<std::string> W;
+		Check(Reader.ParseColumns(Text, I, R, W) == Integers.size(), "every row is read");
+		Check(I == Integers && R == Reals && W == Words, "the columns read are the ones printed");
+		std::vector<int> ParallelI;
+		std::vector<double> ParallelR;
+		std::vector<std::string> ParallelW;
+		Reader.SetWorkers(4);
+		Check(Reader.ParallelParseColumns(Text, ParallelI, ParallelR, ParallelW) == Integers.size(), "every row is read in parallel");
+		Check(ParallelI == Integers && ParallelR == Reals && ParallelW == Words, "the columns read in parallel are the ones printed");
+	}
+}
+
+int main() {
+	std::vector<int> Integers;
+	std::vector<double> Reals;
+	std::vector<std::string> Words;
+	for (int i = 0; i < 100000; ++i) {
+		Integers.push_back(i * 7919 - 300000);
+		Reals.push_back(i / 7.0);
+		Words.push_back(std::string(1 + i % 9, char('a' + i % 26)));
+	}
+
+	InputManager<> Wide;
+	RoundTrip(Wide, " ", Integers, Reals, Words);
+	InputManager<std::string> Narrow;
+	RoundTrip(Narrow, " ", Integers, Reals, Words);
+	InputManager<std::string> Comma(",", "\n");
+	RoundTrip(Comma, ",", Integers, Reals, Words);
+
+	//Columns that already hold different numbers of elements are each appended to. The text must be long enough to be split.
+	std::ostringstream Stream;
+	Stream.precision(17);
+	OutputManager<std::ostream, std::string> Writer(Stream);
+	Writer.FormatToColumns(Integers.begin(), Integers.end(), Reals.begin(), Words.begin());
+	std::vector<int> I{1, 2, 3};
+	std::vector<double> R;
+	std::vector<std::string> W{"w"};
+	Narrow.SetWorkers(4);
+	Narrow.ParallelParseColumns(Stream.str(), I, R, W);
+	Check(I.size() == 3 + Integers.size() && R.size() == Reals.size() && W.size() == 1 + Words.size(), "every column grows by the rows read");
+	Check(std::equal(Integers.begin(), Integers.end(), I.begin() + 3) && R == Reals && std::equal(Words.begin(), Words.end(), W.begin() + 1), "the rows read follow the elements already held");
+	Check(I[2] == 3 && W[0] == "w", "the elements already held are kept");
+
+	//Internal alignment puts padding between the sign and the digits.
+	for (const char* Separator : {" ", ", "}) {
+		std::ostringstream Internal;
+		OutputManager<std::ostream, std::string> Padded(Internal);
+		Padded.SetSeparator(Separator);
+		Padded.SetAlignment(0);
+		Padded.SetWidth(10);
+		std::vector<int> Signed{-5, 3, -123456, 0};
+		std::vector<double> Fractions{-1.5, 2.25, -1e-7, -0.0};
+		Padded.FormatToColumns(Signed.begin(), Signed.end(), Fractions.begin());
+		InputManager<std::string> Reader(Separator, "\n");
+		std::vector<int> ReadSigned;
+		std::vector<double> ReadFractions;
+		bool Read = true;
+		try {
+			Reader.ParseColumns(Internal.str(), ReadSigned, ReadFractions);
+		}
+		catch (std::runtime_error const&) {
+			Read = false;
+		}
+		Check(Read && ReadSigned == Signed && ReadFractions == Fractions, "numbers printed with internal alignment read back");
+	}
+
+	//A malformed line adds nothing to any column.
+	std::vector<int> Kept;
+	std::vector<double> Halves;
+	std::vector<std::string> Names;
+	bool Thrown = false;
+	try {
+		Narrow.ParseColumns("1 0.5 a\n2 x b\n", Kept, Halves, Names);
+	}
+	catch (std::runtime_error const&) {
+		Thrown = true;
+	}
+	Check(Thrown && Kept == std::vector<int>{1} && Halves == std::vector<double>{0.5} && Names == std::vector<std::string>{"a"}, "a malformed line leaves the columns with whole rows");
+
+	//In parallel, a malformed line keeps the rows before it too, those of earlier chunks included.
+	{
+		std::string Text;
+		for (size_t i = 0; i < 300000; ++i) {
+			Text += i == 250000 ? "x 0.5 a\n" : std::to_string(i) + " 0.5 a\n";
+		}
+		std::vector<int> Parallel{-1};
+		std::vector<double> ParallelHalves;
+		std::vector<std::string> ParallelNames;
+		std::string Error;
+		try {
+			Narrow.ParallelParseColumns(Text, Parallel, ParallelHalves, ParallelNames);
+		}
+		catch (std::runtime_error const& Exception) {
+			Error = Exception.what();
+		}
+		Check(Error.find("line 250001") != std::string::npos, "the parallel reader reports the first malformed line");
+		Check(Parallel.size() == 250001 && ParallelHalves.size() == 250000 && ParallelNames.size() == 250000 && Parallel[0] == -1 && Parallel.back() == 249999, "the parallel reader keeps every row before the malformed line");
+	}
+
+	//Wide strings are decoded with the locale the file was written with.
+	std::locale Utf8;
+	try {
+		Utf8 = std::locale("C.UTF-8");
+	}
+	catch (std::runtime_error const&) {
+		return Failures != 0;
+	}
+	{
+		std::vector<int> Numbers{1, 2};
+		std::vector<std::wstring> Names{L"caf\u00e9", L"\u03c0\u03b9"};
+		std::vector<wchar_t> Letters{L'\u00e8', L'a'};
+		{
+			std::wofstream File("InputManagerLocale.txt");
+			File.imbue(Utf8);
+			OutputManager Writer(File);
+			Writer.FormatToColumns(Numbers.begin(), Numbers.end(), Names.begin(), Letters.begin());
+		}
+		InputManager<> Reader;
+		Reader.SetLocale(Utf8);
+		std::vector<int> ReadNumbers;
+		std::vector<std::wstring> ReadNames;
+		std::vector<wchar_t> ReadLetters;
+		Reader.ReadColumns("InputManagerLocale.txt", ReadNumbers, ReadNames, ReadLetters);
+		Check(ReadNumbers == Numbers && ReadNames == Names && ReadLetters == Letters, "wide strings are decoded with the locale of the stream");
+		std::remove("InputManagerLocale.txt");
+	}
+
+	return Failures != 0;
+}
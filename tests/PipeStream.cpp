@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @brief Checks that a slow reader on the other end of a PipeStream gets exactly what OutputManager prints, with and without `vmsplice`.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "PipeStream.h"
+#include "Check.h"
+#include <sstream>
+#include <locale>
+#include <type_traits>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <cerrno>
+#include <sys/wait.h>
+
+namespace {
+	/**
+	 * @brief Text outside ASCII, as wide characters or in UTF-8.
+	 */
+	template<typename CharT> std::basic_string<CharT> Accented() {
+		if constexpr (std::is_same_v<CharT, char>) {
+			return "h\xC3\xA9llo \xE2\x82\xAC \xF0\x9D\x84\x9E";
+		}
+		else {
+			return L"h\u00E9llo \u20AC \U0001D11E";
+		}
+	}
+
+	/**
+	 * @brief Prints the same lines to `Stream`, with text outside ASCII on every line if `Accents` is `true`.
+	 */
+	template<typename CharT> void Print(std::basic_ostream<CharT>& Stream, bool Accents) {
+		OutputManager<std::basic_ostream<CharT>, std::basic_string<CharT>> Manager(Stream);
+		for (int Line = 0; Line < 200000; ++Line) {
+			if (Accents) {
+				Manager(Line, Accented<CharT>(), std::basic_string<CharT>(Line % 30, CharT('a' + Line % 26)));
+			}
+			else {
+				Manager(Line, Line * 0.25, std::basic_string<CharT>(Line % 30, CharT('a' + Line % 26)));
+			}
+		}
+	}
+
+	/**
+	 * @brief Prints through a PipeStream imbued with `Locale` to a child process, which reads slowly and saves what it got to `Path`.
+	 * @param Accents `true` to print text outside ASCII, which `Locale` must encode in UTF-8.
+	 */
+	template<typename CharT> void Compare(std::string const& Path, bool Splice, std::locale const& Locale, bool Accents, const char* What) {
+		int Pipe[2];
+		if (pipe(Pipe) < 0) {
+			Check(false, "the pipe is created");
+			return;
+		}
+		const pid_t Child = fork();
+		if (!Child) {
+			close(Pipe[1]);
+			{
+				std::ofstream Out(Path, std::ios::binary);
+				char Block[1 << 12];
+				size_t Reads = 0;
+				for (ssize_t Count; (Count = read(Pipe[0], Block, sizeof(Block))) > 0 || (Count < 0 && errno == EINTR);) {
+					if (Count > 0) {
+						Out.write(Block, Count);
+						//Lag now and then, so the writer finds the pipe full.
+						if (++Reads % 64 == 0) {
+							usleep(1000);
+						}
+					}
+				}
+			}
+			_exit(0);
+		}
+		close(Pipe[0]);
+		size_t Bytes = 0;
+		{
+			PipeStream<CharT> Stream(Pipe[1], 1 << 16, 1 << 12, Splice);
+			Stream.imbue(Locale);
+			Print(Stream, Accents);
+			Stream.flush();
+			Check(Stream.good(), "the stream stays good");
+			Bytes = Stream.Stats().Bytes;
+		}
+		close(Pipe[1]);
+		waitpid(Child, nullptr, 0);
+		std::ostringstream Expected;
+		Print(Expected, Accents);
+		std::ifstream In(Path, std::ios::binary);
+		const std::string Read((std::istreambuf_iterator<char>(In)), std::istreambuf_iterator<char>());
+		Check(Read == Expected.str(), What);
+		Check(Bytes == Expected.str().size(), "the statistics count every byte");
+		unlink(Path.c_str());
+	}
+}
+
+int main() {
+	const std::string Path = "/tmp/PipeStream." + std::to_string(getpid());
+	const std::locale Classic = std::locale::classic();
+	Compare<char>(Path, false, Classic, false, "narrow text written with write arrives unchanged");
+	Compare<char>(Path, true, Classic, false, "narrow text written with vmsplice arrives unchanged");
+	Compare<wchar_t>(Path, false, Classic, false, "wide text written with write arrives narrowed");
+	Compare<wchar_t>(Path, true, Classic, false, "wide text written with vmsplice arrives narrowed");
+	std::locale Locale;
+	if (Utf8(Locale)) {
+		Compare<wchar_t>(Path, false, Locale, true, "wide text outside ASCII written with write arrives in UTF-8");
+		Compare<wchar_t>(Path, true, Locale, true, "wide text outside ASCII written with vmsplice arrives in UTF-8");
+	}
+
+	return Failures != 0;
+}
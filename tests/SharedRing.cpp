@@ -0,0 +1,132 @@
+/**
+ * @file
+ * @brief Checks that lines written by several processes through SharedRing reach the SharedRingReader whole and in order.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "SharedRing.h"
+#include "Check.h"
+#include <sstream>
+#include <locale>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <sys/wait.h>
+
+namespace {
+	/**
+	 * @brief A type printed with `operator<<` in several pieces, so lines reach the stream in parts.
+	 */
+	struct Pair {
+		int First, Second;
+	};
+
+	template<typename CharT> std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& Stream, Pair const& Value) {
+		return Stream << CharT('(') << Value.First << CharT(',') << Value.Second << CharT(')');
+	}
+
+	/**
+	 * @brief The line `Line` of process `Process` should read as.
+	 */
+	std::string Expected(int Process, int Line) {
+		return std::to_string(Process) + " (" + std::to_string(Line) + ',' + std::to_string(Process) + ") " + std::string(Line % 40, char('a' + Process));
+	}
+}
+
+int main() {
+	const std::string Name = "/SharedRingTest." + std::to_string(getpid());
+	constexpr int Count = 4, Lines = 20000;
+	shm_unlink(Name.c_str());
+	SharedRingReader Reader(Name, 1 << 16);
+	for (int Process = 0; Process < Count; ++Process) {
+		if (!fork()) {
+			{
+				if (Process % 2) {
+					SharedRing<char> Ring(Name);
+					OutputManager<std::ostream, std::string> Manager(Ring);
+					for (int Line = 0; Line < Lines; ++Line) {
+						Manager(Process, Pair{Line, Process}, std::string(Line % 40, char('a' + Process)));
+					}
+				}
+				else {
+					SharedRing<wchar_t> Ring(Name);
+					OutputManager<std::wostream, std::wstring> Manager(Ring);
+					for (int Line = 0; Line < Lines; ++Line) {
+						Manager(Process, Pair{Line, Process}, std::wstring(Line % 40, wchar_t('a' + Process)));
+					}
+				}
+			}
+			_exit(0);
+		}
+	}
+	std::string Text;
+	bool Whole = true;
+	auto Append = [&](const char* Data, size_t Size) {
+		Whole = Whole && Size && Data[Size - 1] == '\n';
+		Text.append(Data, Size);
+	};
+	for (int Done = 0; Done < Count;) {
+		if (!Reader.Drain(Append) && waitpid(-1, nullptr, WNOHANG) > 0) {
+			++Done;
+		}
+	}
+	Reader.Drain(Append);
+	Check(Whole, "every record holds whole lines");
+	std::istringstream In(Text);
+	std::vector<int> Next(Count, 0);
+	bool Ordered = true;
+	for (std::string Line; std::getline(In, Line);) {
+		const int Process = std::atoi(Line.c_str());
+		if (Process < 0 || Process >= Count || Line != Expected(Process, Next[Process])) {
+			Ordered = false;
+			break;
+		}
+		++Next[Process];
+	}
+	Check(Ordered, "lines from several processes do not interleave");
+	Check(Next == std::vector<int>(Count, Lines), "every line of every process is read");
+
+	//An incomplete line waits for its end, unless the stream is flushed.
+	{
+		SharedRing<char> Ring(Name);
+		std::string Out;
+		auto Collect = [&](const char* Data, size_t Size) {
+			Out.append(Data, Size);
+		};
+		Ring << "no end";
+		Reader.Drain(Collect);
+		Check(Out.empty(), "an incomplete line is kept");
+		Ring.flush();
+		Reader.Drain(Collect);
+		Check(Out == "no end", "a flush sends an incomplete line");
+	}
+	//Wide text is encoded by the locale of the stream.
+	std::locale Locale;
+	if (Utf8(Locale)) {
+		SharedRing<wchar_t> Ring(Name);
+		Ring.imbue(Locale);
+		std::string Out;
+		Ring << L"h\u00E9llo \u20AC" << std::flush << L" \U0001D11E\n";
+		Reader.Drain([&](const char* Data, size_t Size) {
+			Out.append(Data, Size);
+		});
+		Check(Out == "h\xC3\xA9llo \xE2\x82\xAC \xF0\x9D\x84\x9E\n", "wide text outside ASCII is sent in the encoding of the locale");
+	}
+	shm_unlink(Name.c_str());
+
+	for (size_t Capacity : {size_t(32), size_t(1) << 31}) {
+		bool Thrown = false;
+		try {
+			SharedRingReader Invalid(Name + "x", Capacity);
+		}
+		catch (std::runtime_error const&) {
+			Thrown = true;
+		}
+		Check(Thrown, "capacities below 64 bytes or not below 2 GiB are rejected");
+		shm_unlink((Name + "x").c_str());
+	}
+
+	return Failures != 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @brief Checks that every non empty line gets a timestamp, whatever prints it: operator(), a LineBatch, PrintRange, FormatToColumns with bounded or unbounded columns, FormatToRows, ParallelFormatToRows, HexDump, or DeferredLog.
+ * @author [Dzegheim](https://github.com/Dzegheim)
+ * @copyright [cc0-1.0](https://creativecommons.org/publicdomain/zero/1.0/deed.en)
+ */
+
+#include "OutputManager.h"
+#include "OutputManagerParallel.h"
+#include "DeferredLog.h"
+#include "Check.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <cctype>
+
+namespace {
+	/**
+	 * @brief Removes the timestamp, the year followed by three digits of a second and the separator, from the start of every non empty line.
+	 * @param Stamped Set to `false` if a non empty line has no timestamp.
+	 */
+	std::string Strip(std::string const& Text, bool& Stamped) {
+		char Year[8];
+		const std::time_t Now = std::time(nullptr);
+		std::strftime(Year, sizeof(Year), "%Y", std::localtime(&Now));
+		const std::string Prefix = std::string("T") + Year + '.';
+		std::string Result;
+		std::istringstream In(Text);
+		Stamped = true;
+		for (std::string Line; std::getline(In, Line);) {
+			const size_t Length = Prefix.size() + 4;
+			if (!Line.empty()) {
+				if (Line.size() >= Length && !Line.compare(0, Prefix.size(), Prefix) && std::isdigit((unsigned char)Line[Prefix.size()]) && std::isdigit((unsigned char)Line[Prefix.size() + 1]) && std::isdigit((unsigned char)Line[Prefix.size() + 2]) && Line[Prefix.size() + 3] == ' ') {
+					Line.erase(0, Length);
+				}
+				else {
+					Stamped = false;
+				}
+			}
+			Result += Line + '\n';
+		}
+		return Result;
+	}
+
+	/**
+	 * @brief Prints the same lines with `Print` with and without a timestamp, and checks that they only differ by it.
+	 */
+	template<typename Function> void Compare(Function&& Print, const char* What) {
+		std::ostringstream Plain, Stamped;
+		{
+			OutputManager<std::ostream, std::string> Manager(Plain);
+			Print(Manager);
+		}
+		{
+			OutputManager<std::ostream, std::string> Manager(Stamped);
+			Manager.SetTimestamp("T%Y", 3);
+			Print(Manager);
+		}
+		bool Every = false;
+		const std::string Stripped = Strip(Stamped.str(), Every);
+		Check(Every && Stripped == Plain.str() && !Plain.str().empty(), What);
+	}
+}
+
+int main() {
+	std::vector<int> Integers;
+	std::vector<double> Reals;
+	std::vector<std::string> Words;
+	for (int i = 0; i < 50000; ++i) {
+		Integers.push_back(i * 31 - 7000);
+		Reals.push_back(i / 7.0);
+		Words.push_back(std::string(i % 7, 'w'));
+	}
+
+	Compare([](auto& Manager) {
+		Manager(1, 2);
+		Manager();
+		Manager("three", 4.5);
+	}, "lines printed by operator() are stamped, blank lines are not");
+	Compare([&](auto& Manager) {
+		Manager.FormatToColumns(Integers.begin(), Integers.end(), Reals.begin());
+	}, "rows of bounded columns printed by FormatToColumns are stamped");
+	Compare([&](auto& Manager) {
+		Manager.FormatToColumns(Integers.begin(), Integers.end(), Words.begin());
+	}, "rows of unbounded columns printed by FormatToColumns are stamped");
+	Compare([&](auto& Manager) {
+		auto Lines = Manager.Batch();
+		for (size_t i = 0; i < 1000; ++i) {
+			Lines(Integers[i], Words[i]);
+		}
+		Lines();
+	}, "lines of a LineBatch are stamped, blank lines are not");
+	Compare([&](auto& Manager) {
+		Manager.PrintRange(Integers.begin(), Integers.begin() + 100);
+		Manager.PrintRange(Words.begin(), Words.begin() + 100);
+		Manager.PrintRange(Words.begin(), Words.begin());
+	}, "lines printed by PrintRange are stamped, empty ranges are not");
+	Compare([&](auto& Manager) {
+		Manager.FormatToRows(Integers.begin(), Integers.end(), Reals.begin(), Words.begin());
+	}, "rows printed by FormatToRows are stamped");
+	Compare([&](auto& Manager) {
+		Manager.SetWorkers(4);
+		Manager.ParallelFormatToRows(Integers.begin(), Integers.end(), Reals.begin(), Words.begin());
+		Manager.ParallelFormatToRows(Integers.begin(), Integers.begin());
+	}, "rows printed by ParallelFormatToRows are stamped once, however they are split, empty rows are not");
+	Compare([&](auto& Manager) {
+		Manager.HexDump(Integers.data(), 5001 * sizeof(int), 16, 4);
+	}, "lines printed by HexDump are stamped");
+	Compare([&](auto& Manager) {
+		DeferredLog Log(Manager);
+		for (size_t i = 0; i < Integers.size(); ++i) {
+			Log(Integers[i], Words[i].c_str(), 0.5 * i);
+		}
+		Log();
+	}, "lines rendered by DeferredLog are stamped");
+	Compare([&](auto& Manager) {
+		std::stringstream Binary;
+		{
+			DeferredLog Log(Binary);
+			for (size_t i = 0; i < Integers.size(); ++i) {
+				Log(Integers[i], Reals[i]);
+			}
+		}
+		DeferredLogDecoder().Decode(Binary, Manager);
+	}, "lines decoded from a binary log are stamped");
+
+	return Failures != 0;
+}